@@ -88,6 +88,15 @@ enum {
 #define SEQ_META_SHIFT  (28 - 4)
 #define SEQ_MULTI_INC (1 << SEQ_MULTI_SHIFT)
 
+//! max number of $-prefixed candidate addresses decoded from a connect string
+#define COMMUDP_CONNSTR_MAXADDR (4)
+
+//! _CommUDPParseConnStr() field flags
+#define COMMUDP_CONNSTR_ADDR    (1)     //!< dotted-quad address present
+#define COMMUDP_CONNSTR_PORT    (2)     //!< first port present
+#define COMMUDP_CONNSTR_PORT2   (4)     //!< second port present
+#define COMMUDP_CONNSTR_CONNID  (8)     //!< '#' connection identifier present
+
 /*** Macros ****************************************************************************/
 
 /*** Type Definitions ******************************************************************/
@@ -220,6 +229,19 @@ struct CommUDPRef
     void (*callproc)(void *ref, int32_t event);
 };
 
+//! decoded "addr:port:port2#$hex$hex-$hex$hex" connect string
+typedef struct CommUDPConnStrT
+{
+    uint32_t uAddr;             //!< address, host order
+    int32_t iPort;              //!< first port
+    int32_t iPort2;             //!< second port
+    uint32_t uConnIdent;        //!< connident hash, as set by _CommUDPSetConnID()
+    const char *pConnID;        //!< connection identifier within the source string (the '#')
+    int32_t iNumAddr;           //!< number of candidate addresses decoded
+    int32_t iNumAddrLocal;      //!< number of candidates before the first '-' separator (-1 if none)
+    uint32_t aAddr[COMMUDP_CONNSTR_MAXADDR];    //!< $-prefixed candidate addresses
+} CommUDPConnStrT;
+
 /*** Function Prototypes ***************************************************************/
 
 /*** Variables *************************************************************************/
@@ -239,6 +261,126 @@ static int32_t      g_missed;
 static int32_t      g_inevent;
 
 
+/*F*************************************************************************************************/
+/*!
+    \Function    _CommUDPParseConnStr
+
+    \Description
+        Decode a connect string of the form "addr:port:port2#$hex$hex-$hex$hex" in a single
+        pass, without allocating. The address must be dotted-quad, one to three digits per
+        octet with no leading zero; anything else before the '#' is skipped, so the
+        connident is decoded for any string _CommUDPSetConnID() accepts. Candidate
+        addresses are exactly eight hex digits each; extras beyond COMMUDP_CONNSTR_MAXADDR
+        are hashed but not stored. The first '-' ends the local candidates.
+
+    \Input *pStrConn    - connect string
+    \Input *pConnStr    - [out] decoded fields
+
+    \Output
+        uint32_t        - COMMUDP_CONNSTR_* flags of the fields present
+
+    \Notes
+        the connident hash includes the '#', as in _CommUDPSetConnID().
+
+    \Version 10/18/2026 (agent)
+*/
+/*************************************************************************************************F*/
+static uint32_t _CommUDPParseConnStr(const char *pStrConn, CommUDPConnStrT *pConnStr)
+{
+    const char *pChar = pStrConn;
+    uint32_t uFields = 0, uValue, uHash;
+    int32_t iOctet, iDigits;
+
+    memset(pConnStr, 0, sizeof(*pConnStr));
+    pConnStr->iNumAddrLocal = -1;
+
+    // dotted-quad address
+    for (iOctet = 0, uValue = 0; iOctet < 4; iOctet += 1)
+    {
+        uint32_t uOctet = 0;
+        for (iDigits = 0; (*pChar >= '0') && (*pChar <= '9') && (iDigits < 3); iDigits += 1, pChar += 1)
+        {
+            uOctet = (uOctet * 10) + (*pChar - '0');
+        }
+        // one to three digits, no leading zero (as SocketInTextGetAddr() in 5.6.2)
+        if ((iDigits == 0) || (uOctet > 255) || ((iDigits > 1) && (pChar[-iDigits] == '0')) || ((*pChar >= '0') && (*pChar <= '9')) || ((iOctet < 3) && (*pChar != '.')))
+        {
+            break;
+        }
+        uValue = (uValue << 8) | uOctet;
+        pChar += (iOctet < 3) ? 1 : 0;
+    }
+    if ((iOctet == 4) && ((*pChar == ':') || (*pChar == '#') || (*pChar == '\0')))
+    {
+        pConnStr->uAddr = uValue;
+        uFields |= COMMUDP_CONNSTR_ADDR;
+
+        // up to two :port suffixes
+        while ((*pChar == ':') && !(uFields & COMMUDP_CONNSTR_PORT2))
+        {
+            for (pChar += 1, uValue = 0, iDigits = 0; (*pChar >= '0') && (*pChar <= '9') && (iDigits < 6); iDigits += 1, pChar += 1)
+            {
+                uValue = (uValue * 10) + (*pChar - '0');
+            }
+            if ((iDigits == 0) || (uValue > 65535))
+            {
+                break;
+            }
+            if (!(uFields & COMMUDP_CONNSTR_PORT))
+            {
+                pConnStr->iPort = (int32_t)uValue;
+                uFields |= COMMUDP_CONNSTR_PORT;
+            }
+            else
+            {
+                pConnStr->iPort2 = (int32_t)uValue;
+                uFields |= COMMUDP_CONNSTR_PORT2;
+            }
+        }
+    }
+
+    // connection identifier; skip anything unexpected before it
+    if ((pConnStr->pConnID = (*pChar == '#') ? pChar : strchr(pChar, '#')) == NULL)
+    {
+        return(uFields);
+    }
+    uFields |= COMMUDP_CONNSTR_CONNID;
+    uHash = 0;
+    iDigits = -1;
+
+    // hash from the '#' (inclusive) while decoding the $-prefixed candidate addresses
+    for (pChar = pConnStr->pConnID; ; pChar += 1)
+    {
+        if ((iDigits >= 0) && (((*pChar >= '0') && (*pChar <= '9')) || (((*pChar | 0x20) >= 'a') && ((*pChar | 0x20) <= 'f'))))
+        {
+            // a ninth digit invalidates the candidate
+            uValue = (uValue << 4) | ((*pChar <= '9') ? (*pChar - '0') : ((*pChar | 0x20) - 'a' + 10));
+            iDigits = (iDigits < 8) ? iDigits + 1 : -1;
+        }
+        else
+        {
+            // a candidate is stored once its digits end
+            if ((iDigits == 8) && (pConnStr->iNumAddr < COMMUDP_CONNSTR_MAXADDR))
+            {
+                pConnStr->aAddr[pConnStr->iNumAddr++] = uValue;
+            }
+            if (*pChar == '\0')
+            {
+                break;
+            }
+            iDigits = (*pChar == '$') ? 0 : -1;
+            uValue = 0;
+            if ((*pChar == '-') && (pConnStr->iNumAddrLocal < 0))
+            {
+                pConnStr->iNumAddrLocal = pConnStr->iNumAddr;
+            }
+        }
+        uHash = (int)*pChar ^ (int)uHash >> 0x1b ^ uHash << 5;
+    }
+    pConnStr->uConnIdent = uHash;
+    return(uFields);
+}
+
 /*F*************************************************************************************************/
 /*!
     \Function    _CommUDPSetConnID
@@ -88,6 +88,15 @@ enum {
 #define SEQ_META_SHIFT  (28 - 4)
 #define SEQ_MULTI_INC (1 << SEQ_MULTI_SHIFT)
 
+//! max number of $-prefixed candidate addresses decoded from a connect string
+#define COMMUDP_CONNSTR_MAXADDR (4)
+
+//! _CommUDPParseConnStr() field flags
+#define COMMUDP_CONNSTR_ADDR    (1)     //!< dotted-quad address present
+#define COMMUDP_CONNSTR_PORT    (2)     //!< first port present
+#define COMMUDP_CONNSTR_PORT2   (4)     //!< second port present
+#define COMMUDP_CONNSTR_CONNID  (8)     //!< '#' connection identifier present
+
 /*** Macros ****************************************************************************/
 
 /*** Type Definitions ******************************************************************/
@@ -220,6 +229,19 @@ struct CommUDPRef
     void (*callproc)(void *ref, int32_t event);
 };
 
+//! decoded "addr:port:port2#$hex$hex-$hex$hex" connect string
+typedef struct CommUDPConnStrT
+{
+    uint32_t uAddr;             //!< address, host order
+    int32_t iPort;              //!< first port
+    int32_t iPort2;             //!< second port
+    uint32_t uConnIdent;        //!< connident hash, as set by _CommUDPSetConnID()
+    const char *pConnID;        //!< connection identifier within the source string (the '#')
+    int32_t iNumAddr;           //!< number of candidate addresses decoded
+    int32_t iNumAddrLocal;      //!< number of candidates before the first '-' separator (-1 if none)
+    uint32_t aAddr[COMMUDP_CONNSTR_MAXADDR];    //!< $-prefixed candidate addresses
+} CommUDPConnStrT;
+
 /*** Function Prototypes ***************************************************************/
 
 /*** Variables *************************************************************************/
@@ -239,6 +261,107 @@ static int32_t      g_missed;
 static int32_t      g_inevent;
 
 
+/*F*************************************************************************************************/
+/*!
+    \Function    _CommUDPParseConnStr
+
+    \Description
+        Decode a connect string of the form "addr:port:port2#$hex$hex-$hex$hex" without
+        allocating. The address must be dotted-quad; anything else before the '#' is
+        skipped, so the connident is decoded for any string _CommUDPSetConnID() accepts.
+        Addresses are parsed with SocketInTextParse(). Candidate addresses are exactly
+        eight hex digits each; extras beyond COMMUDP_CONNSTR_MAXADDR are not stored.
+
+    \Input *pStrConn    - connect string
+    \Input *pConnStr    - [out] decoded fields
+
+    \Output
+        uint32_t        - COMMUDP_CONNSTR_* flags of the fields present
+
+    \Notes
+        the connident hash matches _CommUDPSetConnID().
+
+    \Version 10/18/2026 (agent)
+*/
+/*************************************************************************************************F*/
+static uint32_t _CommUDPParseConnStr(const char *pStrConn, CommUDPConnStrT *pConnStr)
+{
+    const char *pChar, *pEnd;
+    uint32_t uFields = 0, uValue;
+    int32_t iDigits;
+
+    memset(pConnStr, 0, sizeof(*pConnStr));
+    pConnStr->iNumAddrLocal = -1;
+
+    // dotted-quad address
+    if ((*pStrConn != '$') && ((pChar = SocketInTextParse(pStrConn, &uValue)) != NULL) && ((*pChar == ':') || (*pChar == '#') || (*pChar == '\0')))
+    {
+        pConnStr->uAddr = uValue;
+        uFields |= COMMUDP_CONNSTR_ADDR;
+
+        // up to two :port suffixes
+        while ((*pChar == ':') && !(uFields & COMMUDP_CONNSTR_PORT2))
+        {
+            for (pChar += 1, uValue = 0, iDigits = 0; (*pChar >= '0') && (*pChar <= '9') && (iDigits < 6); iDigits += 1, pChar += 1)
+            {
+                uValue = (uValue * 10) + (*pChar - '0');
+            }
+            if ((iDigits == 0) || (uValue > 65535))
+            {
+                break;
+            }
+            if (!(uFields & COMMUDP_CONNSTR_PORT))
+            {
+                pConnStr->iPort = (int32_t)uValue;
+                uFields |= COMMUDP_CONNSTR_PORT;
+            }
+            else
+            {
+                pConnStr->iPort2 = (int32_t)uValue;
+                uFields |= COMMUDP_CONNSTR_PORT2;
+            }
+        }
+    }
+    else
+    {
+        pChar = pStrConn;
+    }
+
+    // connection identifier; skip anything unexpected before it
+    if ((pConnStr->pConnID = (*pChar == '#') ? pChar : strchr(pChar, '#')) == NULL)
+    {
+        return(uFields);
+    }
+    uFields |= COMMUDP_CONNSTR_CONNID;
+    pConnStr->uConnIdent = NetHash(pConnStr->pConnID + 1);
+
+    // $-prefixed candidate addresses; the first '-' ends the local ones
+    for (pChar = pConnStr->pConnID + 1; (pChar = strpbrk(pChar, "$-")) != NULL; )
+    {
+        if (*pChar == '-')
+        {
+            if (pConnStr->iNumAddrLocal < 0)
+            {
+                pConnStr->iNumAddrLocal = pConnStr->iNumAddr;
+            }
+            pChar += 1;
+            continue;
+        }
+        if ((pEnd = SocketInTextParse(pChar, &uValue)) == NULL)
+        {
+            pChar += 1;
+            continue;
+        }
+        // a ninth digit invalidates the candidate
+        if (((uint8_t)(*pEnd - '0') > 9) && ((uint8_t)((*pEnd | 0x20) - 'a') > 5) && (pConnStr->iNumAddr < COMMUDP_CONNSTR_MAXADDR))
+        {
+            pConnStr->aAddr[pConnStr->iNumAddr++] = uValue;
+        }
+        pChar = pEnd;
+    }
+    return(uFields);
+}
+
 /*F*************************************************************************************************/
 /*!
     \Function    _CommUDPSetConnID
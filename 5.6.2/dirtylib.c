@@ -19,32 +19,370 @@
 #include <ctype.h>
 
 #include "dirtysock.h"
+#include "dirtymem.h"
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
 
 // defined in dirtylib<platform>.c
 extern NetCritT *_NetLib_pIdleCrit;
 
 /*** Defines **********************************************************************/
 
+//! one NetHash() step; the signed shift and char sign extension are part of the wire format
+#define NETHASH_STEP(_uHash, _cChar)    ((uint32_t)((int32_t)(_cChar) ^ ((int32_t)(_uHash) >> 0x1b)) ^ ((_uHash) << 5))
+
+//! number of strings NetHashBatch() hashes together
+#define NETHASH_LANES                   (4)
+
+//! NetHash64() mixing constants (odd, balanced-bit 64-bit primes)
+#define NETHASH64_P0    (0x2d358dccaa6c78a5ull)
+#define NETHASH64_P1    (0x8bb84b93962eacc9ull)
+#define NETHASH64_P2    (0x4b33a62ed433d4a3ull)
+#define NETHASH64_P3    (0x4d5a2da51de1aa47ull)
+
+//! number of idle tasks held without allocating
+#define NETIDLE_STATICTASKS             (32)
+
 /*** Type Definitions *************************************************************/
 
+//! idle task
+typedef struct NetIdleTaskT
+{
+    void (*pProc)(void *pRef);          //!< callback, NULL once deleted
+    void *pRef;                         //!< callback parameter
+    uint32_t uInterval;                 //!< milliseconds between calls; zero=every NetIdleCall()
+    uint32_t uDeadline;                 //!< tick the next call is due (interval tasks)
+    int32_t iHeapPos;                   //!< position in the deadline heap, negative if not queued
+    uint8_t bEvery;                     //!< task is in the every-call list
+    uint8_t bRunning;                   //!< task is being called
+    uint8_t _pad[2];
+    NetIdleStatT Stat;
+} NetIdleTaskT;
+
 /*** Variables ********************************************************************/
 
+//! task slots in use or freed (high-water mark)
 static int32_t _NetLib_iIdleSize = 0;
 
-// idle task list
-static struct
-{
-    void (*pProc)(void *pRef);
-    void *pRef;
-} _NetLib_IdleList[32];
+//! capacity of the task, every-call and heap arrays
+static int32_t _NetLib_iIdleMax = NETIDLE_STATICTASKS;
+
+//! every-call tasks (indices into task array) and their count
+static int32_t _NetLib_iIdleEvery = 0;
+
+//! interval tasks, as a min-heap on deadline (indices into task array), and their count
+static int32_t _NetLib_iIdleHeap = 0;
+
+//! idle task storage, until more than NETIDLE_STATICTASKS tasks are added
+static NetIdleTaskT _NetLib_IdleStatic[NETIDLE_STATICTASKS];
+static int32_t _NetLib_aIdleEveryStatic[NETIDLE_STATICTASKS];
+static int32_t _NetLib_aIdleHeapStatic[NETIDLE_STATICTASKS];
+
+//! current idle task storage
+static NetIdleTaskT *_NetLib_pIdleTasks = _NetLib_IdleStatic;
+static int32_t *_NetLib_pIdleEvery = _NetLib_aIdleEveryStatic;
+static int32_t *_NetLib_pIdleHeap = _NetLib_aIdleHeapStatic;
+
+//! memory group of allocated idle task storage
+static int32_t _NetLib_iIdleMemGroup;
+static void *_NetLib_pIdleMemGroupUserData;
 
 #if DIRTYCODE_LOGGING
 //! instantiation of the platform print function
 int (*_Platform_pLogPrintf)(const char *pFmt, ...) = NetPrintfCode;
+
+//! runtime level for NetPrintfLevel() output
+int32_t _NetLib_iLogLevel = NETLOG_INFO;
 #endif
 
 /*** Private Functions ************************************************************/
 
+/*F********************************************************************************/
+/*!
+    \Function _NetIdleHeapSet
+
+    \Description
+        Store a task at a heap position.
+
+    \Input iPos     - heap position
+    \Input iTask    - task index
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static void _NetIdleHeapSet(int32_t iPos, int32_t iTask)
+{
+    _NetLib_pIdleHeap[iPos] = iTask;
+    _NetLib_pIdleTasks[iTask].iHeapPos = iPos;
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _NetIdleHeapFix
+
+    \Description
+        Move the task at a heap position up or down until the heap is ordered.
+
+    \Input iPos     - heap position
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static void _NetIdleHeapFix(int32_t iPos)
+{
+    int32_t iTask = _NetLib_pIdleHeap[iPos], iChild;
+    uint32_t uDeadline = _NetLib_pIdleTasks[iTask].uDeadline;
+
+    // sift up
+    while ((iPos > 0) && (NetTickDiff(uDeadline, _NetLib_pIdleTasks[_NetLib_pIdleHeap[(iPos-1)/2]].uDeadline) < 0))
+    {
+        _NetIdleHeapSet(iPos, _NetLib_pIdleHeap[(iPos-1)/2]);
+        iPos = (iPos-1)/2;
+    }
+    // sift down
+    while ((iChild = (iPos*2)+1) < _NetLib_iIdleHeap)
+    {
+        if (((iChild+1) < _NetLib_iIdleHeap) && (NetTickDiff(_NetLib_pIdleTasks[_NetLib_pIdleHeap[iChild+1]].uDeadline, _NetLib_pIdleTasks[_NetLib_pIdleHeap[iChild]].uDeadline) < 0))
+        {
+            iChild += 1;
+        }
+        if (NetTickDiff(_NetLib_pIdleTasks[_NetLib_pIdleHeap[iChild]].uDeadline, uDeadline) >= 0)
+        {
+            break;
+        }
+        _NetIdleHeapSet(iPos, _NetLib_pIdleHeap[iChild]);
+        iPos = iChild;
+    }
+    _NetIdleHeapSet(iPos, iTask);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _NetIdleHeapRemove
+
+    \Description
+        Remove a task from the deadline heap.
+
+    \Input iTask    - task index
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static void _NetIdleHeapRemove(int32_t iTask)
+{
+    int32_t iPos = _NetLib_pIdleTasks[iTask].iHeapPos;
+
+    _NetLib_pIdleTasks[iTask].iHeapPos = -1;
+    if (--_NetLib_iIdleHeap > iPos)
+    {
+        _NetIdleHeapSet(iPos, _NetLib_pIdleHeap[_NetLib_iIdleHeap]);
+        _NetIdleHeapFix(iPos);
+    }
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _NetIdleGrow
+
+    \Description
+        Double the idle task storage. The caller must hold the idle critical section.
+
+    \Output
+        int32_t     - zero=success, negative=out of memory
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static int32_t _NetIdleGrow(void)
+{
+    int32_t iMax = _NetLib_iIdleMax * 2;
+    NetIdleTaskT *pTasks;
+    int32_t iMemGroup;
+    void *pMemGroupUserData;
+
+    // tasks, every-call list and heap share one allocation
+    DirtyMemGroupQuery(&iMemGroup, &pMemGroupUserData);
+    if ((pTasks = (NetIdleTaskT *)DirtyMemAlloc(iMax * (sizeof(NetIdleTaskT) + 2*sizeof(int32_t)), SOCKET_MEMID, iMemGroup, pMemGroupUserData)) == NULL)
+    {
+        NetPrintfLevel(SOCKET_MEMID, NETLOG_ERROR, ("dirtylib: unable to allocate storage for %d idle tasks\n", iMax));
+        return(-1);
+    }
+    memcpy(pTasks, _NetLib_pIdleTasks, _NetLib_iIdleMax * sizeof(NetIdleTaskT));
+    memcpy(pTasks + iMax, _NetLib_pIdleEvery, _NetLib_iIdleEvery * sizeof(int32_t));
+    memcpy((int32_t *)(pTasks + iMax) + iMax, _NetLib_pIdleHeap, _NetLib_iIdleHeap * sizeof(int32_t));
+
+    if (_NetLib_pIdleTasks != _NetLib_IdleStatic)
+    {
+        DirtyMemFree(_NetLib_pIdleTasks, SOCKET_MEMID, _NetLib_iIdleMemGroup, _NetLib_pIdleMemGroupUserData);
+    }
+    _NetLib_pIdleTasks = pTasks;
+    _NetLib_pIdleEvery = (int32_t *)(pTasks + iMax);
+    _NetLib_pIdleHeap = _NetLib_pIdleEvery + iMax;
+    _NetLib_iIdleMax = iMax;
+    _NetLib_iIdleMemGroup = iMemGroup;
+    _NetLib_pIdleMemGroupUserData = pMemGroupUserData;
+    return(0);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _NetIdleRun
+
+    \Description
+        Call an idle task and record its run time.
+
+    \Input iTask    - task index
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static void _NetIdleRun(int32_t iTask)
+{
+    NetIdleTaskT *pTask = &_NetLib_pIdleTasks[iTask];
+    uint64_t uStart = NetTickUsec(), uElapsed;
+    int32_t iBucket;
+
+    pTask->bRunning = TRUE;
+    pTask->pProc(pTask->pRef);
+
+    // the callback may have added tasks, moving the storage
+    pTask = &_NetLib_pIdleTasks[iTask];
+    pTask->bRunning = FALSE;
+    for (iBucket = 0, uElapsed = (NetTickUsec() - uStart) >> 4; (uElapsed != 0) && (iBucket < (NETIDLE_HISTBUCKETS-1)); uElapsed >>= 2)
+    {
+        iBucket += 1;
+    }
+    pTask->Stat.aRunHist[iBucket] += 1;
+    pTask->Stat.uCalls += 1;
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _NetHashTail
+
+    \Description
+        Continue a NetHash() from an intermediate state.
+
+    \Input *pString    - remaining characters to hash
+    \Input uHash       - hash state so far
+
+    \Output
+        int32_t         - resultant 32bit hash
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static int32_t _NetHashTail(const char *pString, uint32_t uHash)
+{
+    for ( ; *pString != '\0'; pString++)
+    {
+        uHash = NETHASH_STEP(uHash, *pString);
+    }
+    return((int32_t)uHash);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _NetHash64Mum
+
+    \Description
+        Full 64x64->128 bit multiply.
+
+    \Input *pA     - [in/out] first factor, low 64 bits of the product on output
+    \Input *pB     - [in/out] second factor, high 64 bits of the product on output
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static void _NetHash64Mum(uint64_t *pA, uint64_t *pB)
+{
+    #if defined(__SIZEOF_INT128__)
+    unsigned __int128 uProduct = (unsigned __int128)*pA * *pB;
+    *pA = (uint64_t)uProduct;
+    *pB = (uint64_t)(uProduct >> 64);
+    #elif defined(_MSC_VER) && defined(_M_X64)
+    *pA = _umul128(*pA, *pB, pB);
+    #else
+    uint64_t uHa = *pA >> 32, uHb = *pB >> 32, uLa = (uint32_t)*pA, uLb = (uint32_t)*pB;
+    uint64_t uRh = uHa * uHb, uRm0 = uHa * uLb, uRm1 = uHb * uLa, uRl = uLa * uLb;
+    uint64_t uT = uRl + (uRm0 << 32), uLo, uHi;
+    uint32_t uCarry = (uT < uRl);
+    uLo = uT + (uRm1 << 32);
+    uCarry += (uLo < uT);
+    uHi = uRh + (uRm0 >> 32) + (uRm1 >> 32) + uCarry;
+    *pA = uLo;
+    *pB = uHi;
+    #endif
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _NetHash64Mix
+
+    \Description
+        Multiply two values and fold the 128-bit product to 64 bits.
+
+    \Input uA      - first value
+    \Input uB      - second value
+
+    \Output
+        uint64_t    - low ^ high half of the product
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static uint64_t _NetHash64Mix(uint64_t uA, uint64_t uB)
+{
+    _NetHash64Mum(&uA, &uB);
+    return(uA ^ uB);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _NetHash64Read8
+
+    \Description
+        Unaligned host-order 64-bit read.
+
+    \Input *pData  - data to read
+
+    \Output
+        uint64_t    - value read
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static uint64_t _NetHash64Read8(const uint8_t *pData)
+{
+    uint64_t uValue;
+    memcpy(&uValue, pData, sizeof(uValue));
+    return(uValue);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _NetHash64Read4
+
+    \Description
+        Unaligned host-order 32-bit read.
+
+    \Input *pData  - data to read
+
+    \Output
+        uint64_t    - value read
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static uint64_t _NetHash64Read4(const uint8_t *pData)
+{
+    uint32_t uValue;
+    memcpy(&uValue, pData, sizeof(uValue));
+    return(uValue);
+}
+
 /*** Public functions *************************************************************/
 
 
@@ -53,14 +391,24 @@ int (*_Platform_pLogPrintf)(const char *pFmt, ...) = NetPrintfCode;
     \Function NetIdleReset
 
     \Description
-        Reset idle function count.
+        Reset idle function count, releasing any allocated idle task storage.
 
     \Version 06/21/2006 (jbrookes)
 */
 /********************************************************************************F*/
 void NetIdleReset(void)
 {
+    if (_NetLib_pIdleTasks != _NetLib_IdleStatic)
+    {
+        DirtyMemFree(_NetLib_pIdleTasks, SOCKET_MEMID, _NetLib_iIdleMemGroup, _NetLib_pIdleMemGroupUserData);
+        _NetLib_pIdleTasks = _NetLib_IdleStatic;
+        _NetLib_pIdleEvery = _NetLib_aIdleEveryStatic;
+        _NetLib_pIdleHeap = _NetLib_aIdleHeapStatic;
+        _NetLib_iIdleMax = NETIDLE_STATICTASKS;
+    }
     _NetLib_iIdleSize = 0;
+    _NetLib_iIdleEvery = 0;
+    _NetLib_iIdleHeap = 0;
 }
 
 /*F********************************************************************************/
@@ -79,17 +427,78 @@ void NetIdleReset(void)
 /********************************************************************************F*/
 void NetIdleAdd(void (*pProc)(void *pRef), void *pRef)
 {
+    NetIdleAddInterval(pProc, pRef, 0);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function NetIdleAddInterval
+
+    \Description
+        Add a function to the idle callback list, to be called by NetIdleCall() once
+        every uInterval milliseconds. Due tasks are called earliest deadline first;
+        a task that falls more than an interval behind skips the missed calls.
+
+    \Input *pProc       - callback function pointer
+    \Input *pRef        - function specific parameter
+    \Input uInterval    - milliseconds between calls; zero=every NetIdleCall()
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+void NetIdleAddInterval(void (*pProc)(void *pRef), void *pRef, uint32_t uInterval)
+{
+    NetIdleTaskT *pTask;
+    int32_t iTask;
+
     // make sure proc is valid
     if (pProc == NULL)
     {
-        NetPrintf(("dirtylib: attempt to add an invalid idle function\n"));
+        NetPrintfLevel(SOCKET_MEMID, NETLOG_WARNING, ("dirtylib: attempt to add an invalid idle function\n"));
+        return;
+    }
+
+    NetCritEnter(_NetLib_pIdleCrit);
+
+    // reuse a deleted slot that is no longer referenced, else take a new one
+    for (iTask = 0; iTask < _NetLib_iIdleSize; iTask += 1)
+    {
+        pTask = &_NetLib_pIdleTasks[iTask];
+        if ((pTask->pProc == NULL) && !pTask->bEvery && !pTask->bRunning && (pTask->iHeapPos < 0))
+        {
+            break;
+        }
+    }
+    if ((iTask == _NetLib_iIdleMax) && (_NetIdleGrow() < 0))
+    {
+        NetCritLeave(_NetLib_pIdleCrit);
         return;
     }
+    if (iTask == _NetLib_iIdleSize)
+    {
+        _NetLib_iIdleSize += 1;
+    }
 
     // add item to list
-    _NetLib_IdleList[_NetLib_iIdleSize].pProc = pProc;
-    _NetLib_IdleList[_NetLib_iIdleSize].pRef = pRef;
-    _NetLib_iIdleSize += 1;
+    pTask = &_NetLib_pIdleTasks[iTask];
+    memset(pTask, 0, sizeof(*pTask));
+    pTask->pProc = pProc;
+    pTask->pRef = pRef;
+    pTask->uInterval = uInterval;
+    pTask->iHeapPos = -1;
+    if (uInterval == 0)
+    {
+        _NetLib_pIdleEvery[_NetLib_iIdleEvery++] = iTask;
+        pTask->bEvery = TRUE;
+    }
+    else
+    {
+        pTask->uDeadline = NetTick() + uInterval;
+        _NetIdleHeapSet(_NetLib_iIdleHeap++, iTask);
+        _NetIdleHeapFix(pTask->iHeapPos);
+    }
+
+    NetCritLeave(_NetLib_pIdleCrit);
 }
 
 /*F********************************************************************************/
@@ -107,25 +516,33 @@ void NetIdleAdd(void (*pProc)(void *pRef), void *pRef)
 /********************************************************************************F*/
 void NetIdleDel(void (*pProc)(void *pRef), void *pRef)
 {
-    int32_t iProc;
+    int32_t iTask;
 
     // make sure proc is valid
     if (pProc == NULL)
     {
-        NetPrintf(("dirtylib: attempt to delete an invalid idle function\n"));
+        NetPrintfLevel(SOCKET_MEMID, NETLOG_WARNING, ("dirtylib: attempt to delete an invalid idle function\n"));
         return;
     }
 
-    // mark item as deleted
-    for (iProc = 0; iProc < _NetLib_iIdleSize; ++iProc)
+    NetCritEnter(_NetLib_pIdleCrit);
+    for (iTask = 0; iTask < _NetLib_iIdleSize; ++iTask)
     {
-        if ((_NetLib_IdleList[iProc].pProc == pProc) && (_NetLib_IdleList[iProc].pRef == pRef))
+        NetIdleTaskT *pTask = &_NetLib_pIdleTasks[iTask];
+        if ((pTask->pProc == pProc) && (pTask->pRef == pRef))
         {
-            _NetLib_IdleList[iProc].pProc = NULL;
-            _NetLib_IdleList[iProc].pRef = NULL;
+            /* mark item as deleted; every-call entries are dropped by NetIdleCall()
+               so a callback deleting itself does not disturb the walk */
+            pTask->pProc = NULL;
+            pTask->pRef = NULL;
+            if (pTask->iHeapPos >= 0)
+            {
+                _NetIdleHeapRemove(iTask);
+            }
             break;
         }
     }
+    NetCritLeave(_NetLib_pIdleCrit);
 }
 
 /*F********************************************************************************/
@@ -138,60 +555,118 @@ void NetIdleDel(void (*pProc)(void *pRef), void *pRef)
     \Version 09/15/1999 (gschaefer)
 */
 /********************************************************************************F*/
-// void NetIdleDone(void)
-// {
-//     NetCritEnter(_NetLib_pIdleCrit);
-//     NetCritLeave(_NetLib_pIdleCrit);
-// }
+void NetIdleDone(void)
+{
+    NetCritEnter(_NetLib_pIdleCrit);
+    NetCritLeave(_NetLib_pIdleCrit);
+}
 
 /*F********************************************************************************/
 /*!
     \Function NetIdleCall
 
     \Description
-        Call all of the functions in the idle list.
+        Call all of the every-call functions in the idle list, then every interval
+        function whose deadline has passed, earliest deadline first.
 
     \Version 09/15/1999 (gschaefer)
 */
 /********************************************************************************F*/
-// void NetIdleCall(void)
-// {
-//     int32_t iProc;
+void NetIdleCall(void)
+{
+    NetIdleTaskT *pTask;
+    int32_t iEvery, iTask;
+    uint32_t uTick;
 
-//     // only do idle call if we have control
-//     if (NetCritTry(_NetLib_pIdleCrit))
-//     {
-//         // walk the table calling routines
-//         for (iProc = 0; iProc < _NetLib_iIdleSize; ++iProc)
-//         {
-//             // get pProc pointer
-//             void (*pProc)(void *pRef) = _NetLib_IdleList[iProc].pProc;
-//             void *pRef = _NetLib_IdleList[iProc].pRef;
-
-//             /* if pProc is deleted, handle removal here (this
-//                helps prevent corrupting table in race condition) */
-//             if (pProc == NULL)
-//             {
-//                 // swap with final element
-//                 _NetLib_IdleList[iProc].pProc = _NetLib_IdleList[_NetLib_iIdleSize-1].pProc;
-//                 _NetLib_IdleList[iProc].pRef = _NetLib_IdleList[_NetLib_iIdleSize-1].pRef;
-//                 _NetLib_IdleList[_NetLib_iIdleSize-1].pProc = NULL;
-//                 _NetLib_IdleList[_NetLib_iIdleSize-1].pRef = NULL;
-
-//                 // drop the item count
-//                 _NetLib_iIdleSize -= 1;
-
-//                 // restart the loop at new current element
-//                 --iProc;
-//                 continue;
-//             }
-//             // perform the idle call
-//             (*pProc)(pRef);
-//         }
-//         // done with critical section
-//         NetCritLeave(_NetLib_pIdleCrit);
-//     }
-// }
+    // only do idle call if we have control
+    if (!NetCritTry(_NetLib_pIdleCrit))
+    {
+        return;
+    }
+    // refresh the coarse tick once per pass so tasks can read it instead of the clock
+    uTick = (uint32_t)(NetTickUpdate() / 1000);
+
+    // walk the every-call list
+    for (iEvery = 0; iEvery < _NetLib_iIdleEvery; )
+    {
+        iTask = _NetLib_pIdleEvery[iEvery];
+        pTask = &_NetLib_pIdleTasks[iTask];
+
+        /* if pProc is deleted, handle removal here (this
+           helps prevent corrupting table in race condition) */
+        if (pTask->pProc == NULL)
+        {
+            // swap with final element
+            pTask->bEvery = FALSE;
+            _NetLib_pIdleEvery[iEvery] = _NetLib_pIdleEvery[--_NetLib_iIdleEvery];
+            continue;
+        }
+        // perform the idle call
+        _NetIdleRun(iTask);
+        iEvery += 1;
+    }
+
+    // run due interval tasks; each is rescheduled past uTick, so runs at most once per call
+    while ((_NetLib_iIdleHeap > 0) && (NetTickDiff(uTick, _NetLib_pIdleTasks[iTask = _NetLib_pIdleHeap[0]].uDeadline) >= 0))
+    {
+        _NetIdleHeapRemove(iTask);
+        _NetIdleRun(iTask);
+
+        // requeue unless the task was deleted during the call
+        pTask = &_NetLib_pIdleTasks[iTask];
+        if ((pTask->pProc != NULL) && (pTask->iHeapPos < 0))
+        {
+            pTask->uDeadline += pTask->uInterval;
+            if (NetTickDiff(pTask->uDeadline, uTick) <= 0)
+            {
+                // skip every deadline up to and including uTick
+                pTask->Stat.uMissed += (uint32_t)NetTickDiff(uTick, pTask->uDeadline)/pTask->uInterval + 1;
+                pTask->uDeadline = uTick + pTask->uInterval;
+            }
+            _NetIdleHeapSet(_NetLib_iIdleHeap++, iTask);
+            _NetIdleHeapFix(pTask->iHeapPos);
+        }
+    }
+
+    // done with critical section
+    NetCritLeave(_NetLib_pIdleCrit);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function NetIdleStat
+
+    \Description
+        Get run statistics for an idle function.
+
+    \Input *pProc   - callback function pointer
+    \Input *pRef    - function specific parameter
+    \Input *pStat   - [out] statistics
+
+    \Output
+        int32_t     - zero=success, negative=function is not in the idle list
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+int32_t NetIdleStat(void (*pProc)(void *pRef), void *pRef, NetIdleStatT *pStat)
+{
+    int32_t iTask, iResult = -1;
+
+    memset(pStat, 0, sizeof(*pStat));
+    NetCritEnter(_NetLib_pIdleCrit);
+    for (iTask = 0; iTask < _NetLib_iIdleSize; iTask += 1)
+    {
+        if ((_NetLib_pIdleTasks[iTask].pProc == pProc) && (_NetLib_pIdleTasks[iTask].pRef == pRef))
+        {
+            *pStat = _NetLib_pIdleTasks[iTask].Stat;
+            iResult = 0;
+            break;
+        }
+    }
+    NetCritLeave(_NetLib_pIdleCrit);
+    return(iResult);
+}
 
 /*F********************************************************************************/
 /*!
@@ -219,6 +694,144 @@ int32_t NetHash(const char *pString)
     return (int32_t)uHash;
 }
 
+/*F********************************************************************************/
+/*!
+    \Function NetHashBatch
+
+    \Description
+        Calculate NetHash() for many strings at once. Strings are taken four at
+        a time; their common length is hashed in one loop with four independent
+        hash states, so the dependency chains overlap instead of running back to
+        back, and each string's remaining characters are finished on their own.
+
+    \Input **pStrings   - strings to hash
+    \Input *pHashes     - [out] hash of each string, bit-identical to NetHash()
+    \Input iNumStrings  - number of strings
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+void NetHashBatch(const char * const *pStrings, int32_t *pHashes, int32_t iNumStrings)
+{
+    int32_t iString;
+
+    for (iString = 0; (iString + NETHASH_LANES) <= iNumStrings; iString += NETHASH_LANES)
+    {
+        const char *pStr0 = pStrings[iString+0], *pStr1 = pStrings[iString+1];
+        const char *pStr2 = pStrings[iString+2], *pStr3 = pStrings[iString+3];
+        size_t uLen0 = strlen(pStr0), uLen1 = strlen(pStr1), uLen2 = strlen(pStr2), uLen3 = strlen(pStr3);
+        size_t uMinLen = uLen0, uChar;
+        uint32_t uHash0 = 0, uHash1 = 0, uHash2 = 0, uHash3 = 0;
+
+        uMinLen = (uLen1 < uMinLen) ? uLen1 : uMinLen;
+        uMinLen = (uLen2 < uMinLen) ? uLen2 : uMinLen;
+        uMinLen = (uLen3 < uMinLen) ? uLen3 : uMinLen;
+
+        for (uChar = 0; uChar < uMinLen; uChar += 1)
+        {
+            uHash0 = NETHASH_STEP(uHash0, pStr0[uChar]);
+            uHash1 = NETHASH_STEP(uHash1, pStr1[uChar]);
+            uHash2 = NETHASH_STEP(uHash2, pStr2[uChar]);
+            uHash3 = NETHASH_STEP(uHash3, pStr3[uChar]);
+        }
+
+        pHashes[iString+0] = _NetHashTail(pStr0 + uMinLen, uHash0);
+        pHashes[iString+1] = _NetHashTail(pStr1 + uMinLen, uHash1);
+        pHashes[iString+2] = _NetHashTail(pStr2 + uMinLen, uHash2);
+        pHashes[iString+3] = _NetHashTail(pStr3 + uMinLen, uHash3);
+    }
+    for ( ; iString < iNumStrings; iString += 1)
+    {
+        pHashes[iString] = _NetHashTail(pStrings[iString], 0);
+    }
+}
+
+/*F********************************************************************************/
+/*!
+    \Function NetHash64
+
+    \Description
+        Calculate a seeded 64-bit hash of a block of memory, for in-memory hash
+        tables and other internal indexes.
+
+    \Input *pData      - data to hash
+    \Input iLength     - length of data in bytes
+    \Input uSeed       - per-table seed; pick it at runtime so keys cannot be crafted to collide
+
+    \Output
+        uint64_t        - resultant 64-bit hash
+
+    \Notes
+        Unlike NetHash(), every input bit affects every output bit, so keys that
+        differ only in their last characters still spread across the whole table.
+        It is built on 64x64->128 bit multiplies (the wyhash construction) and
+        processes 48 bytes per loop iteration in three independent streams.
+
+        The result depends on host byte order and is not stable across versions;
+        never send it over the wire or persist it. Use NetHash() for connident.
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+uint64_t NetHash64(const void *pData, int32_t iLength, uint64_t uSeed)
+{
+    const uint8_t *pByte = (const uint8_t *)pData;
+    uint64_t uLength = (uint64_t)iLength, uA, uB;
+
+    uSeed ^= _NetHash64Mix(uSeed ^ NETHASH64_P0, NETHASH64_P1);
+    if (iLength <= 16)
+    {
+        if (iLength >= 4)
+        {
+            // two possibly overlapping pairs of 32-bit reads cover 4..16 bytes
+            int32_t iOffset = (iLength >> 3) << 2;
+            uA = (_NetHash64Read4(pByte) << 32) | _NetHash64Read4(pByte + iOffset);
+            uB = (_NetHash64Read4(pByte + iLength - 4) << 32) | _NetHash64Read4(pByte + iLength - 4 - iOffset);
+        }
+        else if (iLength > 0)
+        {
+            uA = ((uint64_t)pByte[0] << 16) | ((uint64_t)pByte[iLength >> 1] << 8) | pByte[iLength - 1];
+            uB = 0;
+        }
+        else
+        {
+            uA = uB = 0;
+        }
+    }
+    else
+    {
+        int32_t iRemain = iLength;
+        if (iRemain > 48)
+        {
+            uint64_t uSeed1 = uSeed, uSeed2 = uSeed;
+            do
+            {
+                uSeed = _NetHash64Mix(_NetHash64Read8(pByte) ^ NETHASH64_P1, _NetHash64Read8(pByte + 8) ^ uSeed);
+                uSeed1 = _NetHash64Mix(_NetHash64Read8(pByte + 16) ^ NETHASH64_P2, _NetHash64Read8(pByte + 24) ^ uSeed1);
+                uSeed2 = _NetHash64Mix(_NetHash64Read8(pByte + 32) ^ NETHASH64_P3, _NetHash64Read8(pByte + 40) ^ uSeed2);
+                pByte += 48;
+                iRemain -= 48;
+            }
+            while (iRemain > 48);
+            uSeed ^= uSeed1 ^ uSeed2;
+        }
+        while (iRemain > 16)
+        {
+            uSeed = _NetHash64Mix(_NetHash64Read8(pByte) ^ NETHASH64_P1, _NetHash64Read8(pByte + 8) ^ uSeed);
+            pByte += 16;
+            iRemain -= 16;
+        }
+        // final 16 bytes, overlapping what was already hashed if needed
+        uA = _NetHash64Read8(pByte + iRemain - 16);
+        uB = _NetHash64Read8(pByte + iRemain - 8);
+    }
+
+    uA ^= NETHASH64_P1;
+    uB ^= uSeed;
+    _NetHash64Mum(&uA, &uB);
+    return(_NetHash64Mix(uA ^ NETHASH64_P0 ^ uLength, uB ^ NETHASH64_P1));
+}
+
 /*F*************************************************************************************************/
 /*!
     \Function NetRand
@@ -251,12 +864,33 @@ int32_t NetHash(const char *pString)
 // }
 
 
+/*F********************************************************************************/
+/*!
+    \Function NetLogSetLevel
+
+    \Description
+        Set the runtime level for NetPrintfLevel() output. Calls above a module's
+        compile-time threshold are not compiled in, whatever this level is.
+
+    \Input iLevel   - NETLOG_* level; lines above it are skipped
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+#if DIRTYCODE_LOGGING
+void NetLogSetLevel(int32_t iLevel)
+{
+    _NetLib_iLogLevel = iLevel;
+}
+#endif
+
 /*F********************************************************************************/
 /*!
     \Function NetPrintfVerboseCode
 
     \Description
-        Display input data if iVerbosityLevel is > iCheckLevel
+        Display input data if iVerbosityLevel is > iCheckLevel. The level is checked
+        before formatting, so suppressed lines cost only the call.
 
     \Input iVerbosityLevel  - current verbosity level
     \Input iCheckLevel      - level to check against
@@ -271,14 +905,16 @@ void NetPrintfVerboseCode(int32_t iVerbosityLevel, int32_t iCheckLevel, const ch
     va_list Args;
     char strText[1024];
 
+    if (iVerbosityLevel <= iCheckLevel)
+    {
+        return;
+    }
+
     va_start(Args, pFormat);
     ds_vsnprintf(strText, sizeof(strText), pFormat, Args);
     va_end(Args);
 
-    if (iVerbosityLevel > iCheckLevel)
-    {
-        NetPrintf(("%s", strText));
-    }
+    NetPrintf(("%s", strText));
 }
 #endif
 
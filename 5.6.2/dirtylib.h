@@ -199,15 +199,46 @@
  #endif
 #endif
 
+//! NetPrintfLevel() levels; higher levels are more detailed
+#define NETLOG_ERROR    (0)
+#define NETLOG_WARNING  (1)
+#define NETLOG_INFO     (2)
+#define NETLOG_VERBOSE  (3)
+#define NETLOG_TRACE    (4)
+
+/* per-module compile-time log thresholds, keyed by memid: NetPrintfLevel() calls above their
+   module's threshold compile to nothing. List them in DIRTYCODE_LOGLEVELS, for example
+   -DDIRTYCODE_LOGLEVELS="NETLOG_THRESHOLD(COMMUDP_MEMID, NETLOG_WARNING) NETLOG_THRESHOLD(SOCKET_MEMID, NETLOG_ERROR)";
+   modules that are not listed use DIRTYCODE_LOGLEVEL_DEFAULT */
+#ifndef DIRTYCODE_LOGLEVELS
+ #define DIRTYCODE_LOGLEVELS
+#endif
+#ifndef DIRTYCODE_LOGLEVEL_DEFAULT
+ #define DIRTYCODE_LOGLEVEL_DEFAULT (NETLOG_TRACE)
+#endif
+#define NETLOG_THRESHOLD(_iModule, _iLevel) (_NETLOG_MODULE == (_iModule)) ? (_iLevel) :
+
+//! give each NetPrintf() call site an interned format id, so NetPrintfBinHook() can log it as a binary record
+#ifndef DIRTYCODE_LOGBINARY
+ #define DIRTYCODE_LOGBINARY (0)
+#endif
+#define _NETPRINTF_ARGS(...) __VA_ARGS__
+
 // debug printing routines
 #if DIRTYCODE_LOGGING
- #define NetPrintf(_x) NetPrintfCode _x
+ #if DIRTYCODE_LOGBINARY
+  #define NetPrintf(_x) { static int32_t _iNetPrintfFmt = 0; NetPrintfBinCode(&_iNetPrintfFmt, _NETPRINTF_ARGS _x); }
+ #else
+  #define NetPrintf(_x) NetPrintfCode _x
+ #endif
  #define NetPrintfVerbose(_x) NetPrintfVerboseCode _x
+ #define NetPrintfLevel(_iModule, _iLevel, _x) { enum { _NETLOG_MODULE = (_iModule) }; if (((_iLevel) <= (DIRTYCODE_LOGLEVELS DIRTYCODE_LOGLEVEL_DEFAULT)) && ((_iLevel) <= _NetLib_iLogLevel)) NetPrintf(_x); }
  #define NetPrintMem(_pMem, _iSize, _pTitle) NetPrintMemCode(_pMem, _iSize, _pTitle)
  #define NetPrintWrap(_pString, _iWrapCol) NetPrintWrapCode(_pString, _iWrapCol)
 #else
  #define NetPrintf(_x) { }
  #define NetPrintfVerbose(_x) { }
+ #define NetPrintfLevel(_iModule, _iLevel, _x) { }
  #define NetPrintMem(_pMem, _iSize, _pTitle) { }
  #define NetPrintWrap(_pString, _iWrapCol) { }
 #endif
@@ -216,8 +247,23 @@
 #define NET_SHUTDOWN_NETACTIVE    (1)   //!< leave network active in preparation for launching to account management (Xbox 360 only)
 #define NET_SHUTDOWN_THREADSTARVE (2)   //!< special shutdown mode for PS3 that starves threads, allowing for quick exit to XMB
 
+//! number of runtime histogram buckets kept per idle task
+#define NETIDLE_HISTBUCKETS       (8)
+
+//! NetCrit contention profiling behind NetCritStat*(); off unless requested, Linux only
+#ifndef DIRTYCODE_CRITSTATS
+ #define DIRTYCODE_CRITSTATS (0)
+#endif
+
+//! number of wait and hold time histogram buckets kept per critical section
+#define NETCRIT_HISTBUCKETS       (8)
+
 /*** Macros ****************************************************************************/
 
+#if !DIRTYCODE_CRITSTATS
+ #define NetCritStatControl(_uSampleRate) {;}
+#endif
+
 /*** Type Definitions ******************************************************************/
 
 //! critical section definition
@@ -226,6 +272,29 @@ typedef struct NetCritT
     int32_t data[(CRIT_SECT_LEN+3)/4];  // force int32_t alignment
 } NetCritT;
 
+//! idle task statistics
+typedef struct NetIdleStatT
+{
+    uint32_t uCalls;                            //!< number of times the task has run
+    uint32_t uMissed;                           //!< interval tasks only: deadlines skipped because a run came a full interval or more late
+    uint32_t aRunHist[NETIDLE_HISTBUCKETS];     //!< run times; bucket 0 counts runs under 16us, bucket n runs of 16*4^(n-1) to 16*4^n-1 us, the last bucket everything longer
+} NetIdleStatT;
+
+//! critical section contention statistics; times are only measured for sampled acquisitions
+typedef struct NetCritStatT
+{
+    char strName[32];                           //!< name passed to NetCritInit()
+    uint32_t uAcquires;                         //!< outermost acquisitions by NetCritEnter() or NetCritTry()
+    uint32_t uContended;                        //!< NetCritEnter() calls that found the section held
+    uint32_t uTryFails;                         //!< NetCritTry() calls that found the section held
+    uint32_t uSampled;                          //!< acquisitions whose hold time was measured
+    uint32_t aWaitHist[NETCRIT_HISTBUCKETS];    //!< sampled contended waits; bucket 0 counts waits under 256ns, bucket n 256*4^(n-1) to 256*4^n-1 ns, the last bucket everything longer
+    uint32_t aHoldHist[NETCRIT_HISTBUCKETS];    //!< sampled hold times, bucketed like aWaitHist
+    uint64_t uMaxHoldNs;                        //!< longest sampled hold
+    int32_t iMaxHoldThread;                     //!< thread id of the longest sampled holder
+    const void *pMaxHoldCaller;                 //!< return address of the call that took the longest sampled hold
+} NetCritStatT;
+
 /*** Variables *************************************************************************/
 
 /*** Functions *************************************************************************/
@@ -244,6 +313,9 @@ void NetIdleReset(void);
 // remove a function to the idle callback list.
 void NetIdleAdd(void (*proc)(void *ref), void *ref);
 
+// add a function to the idle callback list, called at most every uInterval milliseconds
+void NetIdleAddInterval(void (*proc)(void *ref), void *ref, uint32_t uInterval);
+
 // call all the functions in the idle list.
 void NetIdleDel(void (*proc)(void *ref), void *ref);
 
@@ -253,6 +325,9 @@ void NetIdleDone(void);
 // add a function to the idle callback list
 void NetIdleCall(void);
 
+// get run statistics for an idle function
+int32_t NetIdleStat(void (*proc)(void *ref), void *ref, NetIdleStatT *pStat);
+
 // print memory as hex (do not call directly; use NetPrintMem() wrapper)
 void NetPrintMemCode(const void *pMem, int32_t iSize, const char *pTitle);
 
@@ -275,12 +350,30 @@ void NetLibDestroy2(uint32_t uShutdownFlags);
 // return an increasing tick count with millisecond scale
 uint32_t NetTick(void);
 
+// return an increasing 64-bit tick count with millisecond scale (does not wrap)
+uint64_t NetTick64(void);
+
+// return an increasing 64-bit tick count with microsecond scale (does not wrap)
+uint64_t NetTickUsec(void);
+
+// refresh the process-wide cached coarse tick and return it
+uint64_t NetTickUpdate(void);
+
+// return the cached coarse tick from the last NetTickUpdate() on any thread, in microseconds
+uint64_t NetTickCoarseUsec(void);
+
 // return signed difference between new tick count and old tick count (new - old)
 #define NetTickDiff(_uNewTime, _uOldTime) ((signed)((_uNewTime) - (_uOldTime)))
 
 // return 32-bit hash from given input string
 int32_t NetHash(const char *pString);
 
+// return NetHash() of each of the given strings
+void NetHashBatch(const char * const *pStrings, int32_t *pHashes, int32_t iNumStrings);
+
+// return seeded 64-bit hash of a block of memory, for internal lookup tables only
+uint64_t NetHash64(const void *pData, int32_t iLength, uint64_t uSeed);
+
 // A simple psuedo-random sequence generator
 uint32_t NetRand(uint32_t uLimit);
 
@@ -293,6 +386,27 @@ void NetPrintfVerboseCode(int32_t iVerbosityLevel, int32_t iCheckLevel, const ch
 // hook into debug output
 #if DIRTYCODE_LOGGING
 void NetPrintfHook(int32_t (*pPrintfDebugHook)(void *pParm, const char *pText), void *pParm);
+
+// send debug output from a background thread, so logging never waits on the hook
+int32_t NetPrintfAsyncStart(void);
+
+// write all queued debug output and stop the background thread
+void NetPrintfAsyncStop(void);
+
+// log a call site as a binary record if a binary sink is set, else as text (do not call directly, use NetPrintf() wrapper)
+int32_t NetPrintfBinCode(int32_t *pFmtId, const char *pFormat, ...);
+
+// send NetPrintf() output to a binary sink as format id, timestamp and raw arguments (NULL=text output)
+void NetPrintfBinHook(int32_t (*pBinHook)(void *pParm, const void *pData, int32_t iLength), void *pParm);
+
+// render the arguments of a binary record as text with its format
+int32_t NetPrintfBinRender(const char *pFormat, const uint8_t *pArgs, int32_t iArgLen, char *pBuffer, int32_t iBufSize);
+
+// runtime level checked by NetPrintfLevel() (do not access directly, use NetLogSetLevel())
+extern int32_t _NetLib_iLogLevel;
+
+// set the runtime level for NetPrintfLevel() output; lines above it are skipped before formatting
+void NetLogSetLevel(int32_t iLevel);
 #endif
 
 // initialize a critical section for use -- includes name for verbose debugging on some platforms
@@ -310,8 +424,37 @@ void NetCritEnter(NetCritT *pCrit);
 // leave a critical section
 void NetCritLeave(NetCritT *pCrit);
 
+#if DIRTYCODE_CRITSTATS
+// set the critical section sampling rate: time one in uSampleRate acquisitions per thread (zero=count only)
+void NetCritStatControl(uint32_t uSampleRate);
+
+// get contention statistics for the first critical section with the given name
+int32_t NetCritStatGet(const char *pCritName, NetCritStatT *pStat);
+
+// format a contention report into a buffer, or to debug output if pBuffer is NULL
+int32_t NetCritStatReport(char *pBuffer, int32_t iBufSize);
+#endif
+
 #ifdef __cplusplus
 }
+
+/*
+ Compile-time NetHash() for string literals, e.g. for switch labels or static tables.
+ Recursion depth equals the string length, so keep keys within the compiler's
+ constexpr depth limit (512 by default).
+*/
+
+//! one NetHash() step per character (do not call directly; use NetHashConst())
+constexpr uint32_t _NetHashConst(const char *pString, uint32_t uHash)
+{
+    return((*pString == '\0') ? uHash : _NetHashConst(pString + 1, (uint32_t)((int32_t)*pString ^ ((int32_t)uHash >> 0x1b)) ^ (uHash << 5)));
+}
+
+//! return NetHash() of a string literal at compile time
+constexpr int32_t NetHashConst(const char *pString)
+{
+    return((int32_t)_NetHashConst(pString, 0));
+}
 #endif
 
 //@}
@@ -0,0 +1,1910 @@
+/*H********************************************************************************/
+/*!
+    \File dirtylibunix.c
+
+    \Description
+        Platform specific support library for Linux and other Unix platforms.
+
+    \Notes
+        NetTickUsec() reads CLOCK_MONOTONIC, which glibc serves from the vDSO on
+        Linux, so it costs a few nanoseconds and no system call. NetTick() and
+        NetTick64() are derived from it so all three agree. Code that reads the time
+        many times per update can use NetTickCoarseUsec() instead, which returns the
+        process-wide value cached by the last NetTickUpdate() from any thread;
+        NetIdleCall() refreshes it at the start of each pass.
+
+        On Linux, NetCrit is a recursive lock built on a futex word instead of a
+        pthread mutex. An uncontended enter or leave is a single atomic operation.
+        A contended enter spins briefly before sleeping in the kernel, because the
+        sections guarded by NetCrit are usually shorter than a sleep and wakeup.
+        The spin limit is twice the running average of the spins that recent
+        contended acquisitions of that lock needed, kept between 10 and 100.
+        Other Unix platforms use a recursive pthread mutex.
+
+        Building with DIRTYCODE_CRITSTATS adds contention profiling to the Linux
+        NetCrit, keyed by the name given to NetCritInit(). Acquisition and contention
+        counts are always kept. They cost a few plain increments made while the lock
+        is held. Wait and hold times are measured for one in N acquisitions per
+        thread, as set by NetCritStatControl(), so a high rate can stay on in
+        production.
+
+        With DIRTYCODE_LOGGING, NetPrintfCode() formats the line and hands it to the
+        NetPrintfHook() sink, or stdout when there is no hook. After
+        NetPrintfAsyncStart(), calling threads only format and copy the line into a
+        per-thread ring. A background thread drains the rings into the sink, so a
+        slow sink never blocks the caller. A line that does not fit in its ring is
+        dropped and counted rather than waited on. There are NETPRINTF_RINGS rings,
+        each owned by one thread until it exits; lines from further threads are
+        dropped and counted the same way. Each thread's lines keep their order, but
+        lines from different threads may be interleaved differently than they were
+        logged.
+
+        NetPrintfBinHook() switches debug output to binary records. Building with
+        DIRTYCODE_LOGBINARY gives each NetPrintf() call site a static format id.
+        The format is parsed once, and its text is sent as a definition record the
+        first time the site logs to each hook. After that, a record holds only the
+        id, a NetTickUsec() timestamp and the raw arguments, with strings copied.
+        Nothing is formatted on the calling thread. With async output, records are
+        drained ring by ring, so a definition can follow a record from another
+        thread that uses it; decoders read every definition before rendering.
+        NetPrintfBinRender() turns a record back into text offline. Formats must be
+        string literals, and formats using '*', %n, %lc, %ls or long double stay
+        text.
+
+    \Version 10/18/2026 (agent) First Version
+*/
+/********************************************************************************H*/
+
+/*** Include files ****************************************************************/
+
+#include <time.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include <pthread.h>
+
+#include "dirtysock.h"
+
+/*** Defines **********************************************************************/
+
+//! futex lock word states
+#define NETCRIT_UNLOCKED    (0)
+#define NETCRIT_LOCKED      (1)
+#define NETCRIT_CONTENDED   (2)     //!< locked, and other threads may be sleeping on it
+
+//! bounds for the adaptive spin before sleeping
+#define NETCRIT_SPINMIN     (10)
+#define NETCRIT_SPINMAX     (100)
+
+//! maximum number of critical sections profiled at once
+#define NETCRIT_STATMAX     (64)
+
+//! async debug output: rings (threads logging at once), bytes per ring (power of two), longest line
+#define NETPRINTF_RINGS     (16)
+#define NETPRINTF_RINGSIZE  (16*1024)
+#define NETPRINTF_MAXTEXT   (1024)
+
+//! record length that tells the reader to skip to the start of the ring
+#define NETPRINTF_RINGWRAP  (0xffffffff)
+
+//! ring record length flag marking a binary record
+#define NETPRINTF_RINGBIN   (0x80000000)
+
+//! binary debug output: interned formats, arguments per format, record header size
+#define NETPRINTF_BINFORMATS    (4096)
+#define NETPRINTF_BINMAXARGS    (16)
+#define NETPRINTF_BINHEADER     (12)
+
+#if defined(__x86_64__) || defined(__i386__)
+ #define NETCRIT_PAUSE()    __builtin_ia32_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+ #define NETCRIT_PAUSE()    __asm__ __volatile__("yield")
+#else
+ #define NETCRIT_PAUSE()
+#endif
+
+/*** Type Definitions *************************************************************/
+
+#if defined(__linux__)
+//! futex critical section, stored in NetCritT.data
+typedef struct NetCritFutexT
+{
+    int32_t iState;         //!< NETCRIT_* lock word
+    int32_t iOwner;         //!< thread id of the holder, zero if unlocked
+    int32_t iDepth;         //!< recursion depth of the holder
+    int32_t iSpin;          //!< running average of spins a contended acquisition needed, times 8
+    #if DIRTYCODE_CRITSTATS
+    int32_t iStat;          //!< statistics slot plus one, zero if the table was full
+    #endif
+} NetCritFutexT;
+
+typedef char NetCritFutexFitsT[(sizeof(NetCritFutexT) <= sizeof(NetCritT)) ? 1 : -1];
+
+#if DIRTYCODE_CRITSTATS
+//! profiling slot for one critical section; written only by the holder, except iUsed and uTryFails
+typedef struct NetCritStatEntryT
+{
+    NetCritStatT Stat;
+    uint64_t uHoldStart;        //!< start of the current hold, if it is sampled
+    const void *pHoldCaller;    //!< caller that took the current hold, if it is sampled
+    uint32_t bHoldSampled;      //!< TRUE if the current hold is being timed
+    int32_t iUsed;              //!< nonzero while a critical section owns the slot
+    NetCritFutexT *pOwner;      //!< section that owns the slot; a second init without a kill reuses it
+} NetCritStatEntryT;
+
+//! report state
+typedef struct NetCritStatReportT
+{
+    char *pBuffer;
+    int32_t iBufSize;
+    int32_t iLength;
+} NetCritStatReportT;
+#endif
+#endif
+
+#if DIRTYCODE_LOGGING
+//! single-producer single-consumer ring of debug output lines, owned by one thread at a time
+typedef struct NetPrintfRingT
+{
+    uint32_t uHead;             //!< write offset, advanced by the owning thread
+    uint32_t uDropped;          //!< lines dropped because the ring was full
+    int32_t iOwned;             //!< nonzero while a thread owns the ring
+    int32_t iWriting;           //!< nonzero while the owner is adding a line
+    uint8_t _pad0[48];
+    uint32_t uTail;             //!< read offset, advanced by the background thread
+    uint32_t uDropReported;     //!< uDropped value last reported by the background thread
+    uint8_t _pad1[56];
+    char aData[NETPRINTF_RINGSIZE];
+} NetPrintfRingT;
+
+//! async debug output state
+typedef struct NetPrintfAsyncT
+{
+    NetPrintfRingT aRings[NETPRINTF_RINGS];
+    pthread_t Thread;
+    pthread_key_t RingKey;      //!< releases a thread's ring when it exits
+    int32_t iRunning;           //!< nonzero while lines go through the rings
+    int32_t iStop;              //!< tells the background thread to drain and exit
+    uint32_t uDropped;          //!< lines dropped because every ring was owned by another thread
+    uint32_t uDropReported;     //!< uDropped value last reported by the background thread
+    int32_t iDropping;          //!< threads without a ring that are counting a dropped line
+    uint32_t bRingKey;          //!< TRUE once RingKey has been created; it is kept for the process lifetime
+} NetPrintfAsyncT;
+
+//! interned format
+typedef struct NetPrintfBinFmtT
+{
+    char strTypes[NETPRINTF_BINMAXARGS+1];  //!< argument type of each conversion; see _NetPrintfBinSpec()
+    int32_t iGeneration;                    //!< binary hook generation the definition was last sent to
+} NetPrintfBinFmtT;
+#endif
+
+/*** Variables ********************************************************************/
+
+//! tick cached by the last NetTickUpdate() from any thread, in microseconds; only moves forward
+static uint64_t _NetLib_uCoarseUsec = 0;
+
+#if defined(__linux__)
+//! calling thread's id, cached for NetCrit ownership checks
+static DIRTYCODE_THREADLOCAL int32_t _NetLib_iThreadId = 0;
+
+#if DIRTYCODE_CRITSTATS
+//! profiling slots
+static NetCritStatEntryT _NetLib_aCritStats[NETCRIT_STATMAX];
+
+//! time one in this many acquisitions per thread (zero=count only)
+static uint32_t _NetLib_uCritSampleRate = 0;
+
+//! calling thread's acquisition counter for sampling
+static DIRTYCODE_THREADLOCAL uint32_t _NetLib_uCritSample = 0;
+#endif
+#endif
+
+#if DIRTYCODE_LOGGING
+//! debug output sink set by NetPrintfHook()
+static int32_t (*_NetLib_pDebugHook)(void *pParm, const char *pText) = NULL;
+static void *_NetLib_pDebugParm = NULL;
+
+//! async debug output state
+static NetPrintfAsyncT _NetLib_PrintfAsync;
+
+//! calling thread's ring, if it has one
+static DIRTYCODE_THREADLOCAL NetPrintfRingT *_NetLib_pPrintfRing = NULL;
+
+//! binary debug output sink set by NetPrintfBinHook(), and how many times it has been set
+static int32_t (*_NetLib_pBinHook)(void *pParm, const void *pData, int32_t iLength) = NULL;
+static void *_NetLib_pBinParm = NULL;
+static int32_t _NetLib_iBinGeneration = 0;
+
+//! interned formats; id zero is reserved for definition records
+static NetPrintfBinFmtT _NetLib_aBinFormats[NETPRINTF_BINFORMATS];
+static int32_t _NetLib_iBinFormats = 0;
+#endif
+
+/*** Private Functions ************************************************************/
+
+#if defined(__linux__)
+/*F********************************************************************************/
+/*!
+    \Function _NetCritThreadId
+
+    \Description
+        Return the calling thread's id.
+
+    \Output
+        int32_t     - nonzero thread id
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static int32_t _NetCritThreadId(void)
+{
+    if (_NetLib_iThreadId == 0)
+    {
+        _NetLib_iThreadId = (int32_t)syscall(SYS_gettid);
+    }
+    return(_NetLib_iThreadId);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _NetCritAcquired
+
+    \Description
+        Record ownership after the lock word has been taken.
+
+    \Input *pCrit   - critical section
+    \Input iSelf    - calling thread's id
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static void _NetCritAcquired(NetCritFutexT *pCrit, int32_t iSelf)
+{
+    __atomic_store_n(&pCrit->iOwner, iSelf, __ATOMIC_RELAXED);
+    pCrit->iDepth = 1;
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _NetCritWait
+
+    \Description
+        Acquire a lock that was held on the first attempt: spin for a while, then
+        sleep on the futex until the lock is handed over.
+
+    \Input *pCrit   - critical section
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static void _NetCritWait(NetCritFutexT *pCrit)
+{
+    int32_t iSpin, iMaxSpin, iState;
+
+    // spin up to twice what recent acquisitions needed, only reading the word until it looks free
+    iMaxSpin = __atomic_load_n(&pCrit->iSpin, __ATOMIC_RELAXED) / 4;
+    iMaxSpin = (iMaxSpin > NETCRIT_SPINMIN) ? iMaxSpin : NETCRIT_SPINMIN;
+    iMaxSpin = (iMaxSpin < NETCRIT_SPINMAX) ? iMaxSpin : NETCRIT_SPINMAX;
+    for (iSpin = 0; iSpin < iMaxSpin; iSpin += 1)
+    {
+        NETCRIT_PAUSE();
+        iState = NETCRIT_UNLOCKED;
+        if ((__atomic_load_n(&pCrit->iState, __ATOMIC_RELAXED) == NETCRIT_UNLOCKED) &&
+            __atomic_compare_exchange_n(&pCrit->iState, &iState, NETCRIT_LOCKED, FALSE,
+                __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        {
+            break;
+        }
+    }
+
+    // sleep, marking the word contended so the holder knows to wake us
+    if (iSpin == iMaxSpin)
+    {
+        while (__atomic_exchange_n(&pCrit->iState, NETCRIT_CONTENDED, __ATOMIC_ACQUIRE) != NETCRIT_UNLOCKED)
+        {
+            syscall(SYS_futex, &pCrit->iState, FUTEX_WAIT_PRIVATE, NETCRIT_CONTENDED, NULL, NULL, 0);
+        }
+    }
+
+    /* only the holder updates the average; waiters read it without the lock. it is kept
+       times 8 so the 1/8 step does not truncate and the average can decay to zero */
+    __atomic_store_n(&pCrit->iSpin, pCrit->iSpin + iSpin - (pCrit->iSpin / 8), __ATOMIC_RELAXED);
+}
+
+#if DIRTYCODE_CRITSTATS
+/*F********************************************************************************/
+/*!
+    \Function _NetCritStatNsec
+
+    \Description
+        Return a monotonic timestamp for wait and hold timing.
+
+    \Output
+        uint64_t    - nanoseconds since an arbitrary fixed point
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static uint64_t _NetCritStatNsec(void)
+{
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+    return((uint64_t)Now.tv_sec * 1000000000 + (uint64_t)Now.tv_nsec);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _NetCritStatBucket
+
+    \Description
+        Return the histogram bucket for a wait or hold time.
+
+    \Input uNsec    - time in nanoseconds
+
+    \Output
+        int32_t     - bucket index; see NetCritStatT.aWaitHist
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static int32_t _NetCritStatBucket(uint64_t uNsec)
+{
+    int32_t iBucket;
+
+    for (iBucket = 0, uNsec >>= 8; (uNsec != 0) && (iBucket < (NETCRIT_HISTBUCKETS-1)); uNsec >>= 2)
+    {
+        iBucket += 1;
+    }
+    return(iBucket);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _NetCritStatRegister
+
+    \Description
+        Give a critical section a profiling slot, if one is free.
+
+    \Input *pCrit       - critical section
+    \Input *pCritName   - critical section name
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static void _NetCritStatRegister(NetCritFutexT *pCrit, const char *pCritName)
+{
+    NetCritStatEntryT *pEntry = NULL;
+    int32_t iSlot, iUsed;
+
+    // a section initialized again without a kill keeps its slot
+    for (iSlot = 0; iSlot < NETCRIT_STATMAX; iSlot += 1)
+    {
+        if (__atomic_load_n(&_NetLib_aCritStats[iSlot].pOwner, __ATOMIC_ACQUIRE) == pCrit)
+        {
+            pEntry = &_NetLib_aCritStats[iSlot];
+            break;
+        }
+    }
+    // otherwise claim a free one
+    for (iSlot = 0; (pEntry == NULL) && (iSlot < NETCRIT_STATMAX); iSlot += 1)
+    {
+        iUsed = 0;
+        if ((__atomic_load_n(&_NetLib_aCritStats[iSlot].iUsed, __ATOMIC_RELAXED) == 0) &&
+            __atomic_compare_exchange_n(&_NetLib_aCritStats[iSlot].iUsed, &iUsed, 1, FALSE,
+                __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        {
+            pEntry = &_NetLib_aCritStats[iSlot];
+            __atomic_store_n(&pEntry->pOwner, pCrit, __ATOMIC_RELEASE);
+        }
+    }
+    if (pEntry == NULL)
+    {
+        return;
+    }
+
+    memset(&pEntry->Stat, 0, sizeof(pEntry->Stat));
+    strncpy(pEntry->Stat.strName, (pCritName != NULL) ? pCritName : "", sizeof(pEntry->Stat.strName) - 1);
+    pEntry->bHoldSampled = FALSE;
+    pCrit->iStat = (int32_t)(pEntry - _NetLib_aCritStats) + 1;
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _NetCritStatSample
+
+    \Description
+        Decide whether the calling thread should time this acquisition.
+
+    \Input *pCrit   - critical section
+
+    \Output
+        uint32_t    - TRUE if the acquisition should be timed
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static uint32_t _NetCritStatSample(NetCritFutexT *pCrit)
+{
+    uint32_t uSampleRate = __atomic_load_n(&_NetLib_uCritSampleRate, __ATOMIC_RELAXED);
+    return((pCrit->iStat != 0) && (uSampleRate != 0) && ((++_NetLib_uCritSample % uSampleRate) == 0));
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _NetCritStatAcquired
+
+    \Description
+        Record an outermost acquisition; called by the new holder.
+
+    \Input *pCrit       - critical section
+    \Input bSampled     - TRUE if the acquisition is timed
+    \Input bContended   - TRUE if the section was held on the first attempt
+    \Input uWaitStart   - when the wait began, if sampled and contended
+    \Input *pCaller     - return address of the acquiring call
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static void _NetCritStatAcquired(NetCritFutexT *pCrit, uint32_t bSampled, uint32_t bContended,
+    uint64_t uWaitStart, const void *pCaller)
+{
+    NetCritStatEntryT *pEntry;
+    uint64_t uNow;
+
+    if (pCrit->iStat == 0)
+    {
+        return;
+    }
+    pEntry = &_NetLib_aCritStats[pCrit->iStat - 1];
+    pEntry->Stat.uAcquires += 1;
+    pEntry->Stat.uContended += bContended;
+    if (bSampled)
+    {
+        uNow = _NetCritStatNsec();
+        if (bContended)
+        {
+            pEntry->Stat.aWaitHist[_NetCritStatBucket(uNow - uWaitStart)] += 1;
+        }
+        pEntry->uHoldStart = uNow;
+        pEntry->pHoldCaller = pCaller;
+        pEntry->bHoldSampled = TRUE;
+    }
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _NetCritStatReleased
+
+    \Description
+        Record the end of an outermost hold; called by the holder before the lock
+        word is released.
+
+    \Input *pCrit   - critical section
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static void _NetCritStatReleased(NetCritFutexT *pCrit)
+{
+    NetCritStatEntryT *pEntry;
+    uint64_t uHold;
+
+    if ((pCrit->iStat == 0) || !(pEntry = &_NetLib_aCritStats[pCrit->iStat - 1])->bHoldSampled)
+    {
+        return;
+    }
+    uHold = _NetCritStatNsec() - pEntry->uHoldStart;
+    pEntry->Stat.aHoldHist[_NetCritStatBucket(uHold)] += 1;
+    pEntry->Stat.uSampled += 1;
+    if (uHold > pEntry->Stat.uMaxHoldNs)
+    {
+        pEntry->Stat.uMaxHoldNs = uHold;
+        pEntry->Stat.iMaxHoldThread = pCrit->iOwner;
+        pEntry->Stat.pMaxHoldCaller = pEntry->pHoldCaller;
+    }
+    pEntry->bHoldSampled = FALSE;
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _NetCritStatPrintf
+
+    \Description
+        Append a line to a report buffer, or send it to debug output.
+
+    \Input *pReport - report state
+    \Input *pFormat - format string
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static void _NetCritStatPrintf(NetCritStatReportT *pReport, const char *pFormat, ...)
+{
+    char strLine[256];
+    int32_t iLength;
+    va_list Args;
+
+    va_start(Args, pFormat);
+    iLength = vsnprintf(strLine, sizeof(strLine), pFormat, Args);
+    va_end(Args);
+    if (iLength >= (int32_t)sizeof(strLine))
+    {
+        iLength = sizeof(strLine) - 1;
+    }
+
+    if (pReport->pBuffer == NULL)
+    {
+        NetPrintf(("%s", strLine));
+    }
+    else if ((pReport->iLength + iLength) < pReport->iBufSize)
+    {
+        memcpy(pReport->pBuffer + pReport->iLength, strLine, iLength + 1);
+    }
+    pReport->iLength += iLength;
+}
+#endif // DIRTYCODE_CRITSTATS
+#endif
+
+#if DIRTYCODE_LOGGING
+/*F********************************************************************************/
+/*!
+    \Function _NetPrintfWrite
+
+    \Description
+        Write a line of debug output to the sink.
+
+    \Input *pText   - text to write
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static void _NetPrintfWrite(const char *pText)
+{
+    int32_t (*pDebugHook)(void *pParm, const char *pText) = _NetLib_pDebugHook;
+
+    if (pDebugHook != NULL)
+    {
+        pDebugHook(_NetLib_pDebugParm, pText);
+    }
+    else
+    {
+        fputs(pText, stdout);
+    }
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _NetPrintfBinWrite
+
+    \Description
+        Write a binary record to the binary sink.
+
+    \Input *pData   - record
+    \Input iLength  - record length
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static void _NetPrintfBinWrite(const void *pData, int32_t iLength)
+{
+    int32_t (*pBinHook)(void *pParm, const void *pData, int32_t iLength) = _NetLib_pBinHook;
+
+    if (pBinHook != NULL)
+    {
+        pBinHook(_NetLib_pBinParm, pData, iLength);
+    }
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _NetPrintfRingRelease
+
+    \Description
+        Thread exit destructor; give the thread's ring back for reuse. Lines still
+        in the ring are drained as usual.
+
+    \Input *pRing   - ring owned by the exiting thread
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static void _NetPrintfRingRelease(void *pRing)
+{
+    __atomic_store_n(&((NetPrintfRingT *)pRing)->iOwned, 0, __ATOMIC_RELEASE);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _NetPrintfRingPut
+
+    \Description
+        Add a line to the calling thread's ring, claiming a ring first if needed.
+        When all NETPRINTF_RINGS rings are owned by other threads, the line is
+        dropped and counted like a line that does not fit, so the caller never
+        writes to the sink while async output is running.
+
+    \Input *pData   - text of the line, or a binary record
+    \Input iLength  - length of the data, without terminator
+    \Input uFlag    - NETPRINTF_RINGBIN for a binary record, else zero
+
+    \Output
+        uint32_t    - TRUE if the line was queued or dropped, FALSE if the caller must write it
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static uint32_t _NetPrintfRingPut(const void *pData, int32_t iLength, uint32_t uFlag)
+{
+    NetPrintfRingT *pRing = _NetLib_pPrintfRing;
+    uint32_t uHead, uOffset, uSize, uContig, uNeed, uLength;
+    int32_t iRing, iOwned;
+
+    // claim a ring on this thread's first line
+    for (iRing = 0; (pRing == NULL) && (iRing < NETPRINTF_RINGS); iRing += 1)
+    {
+        iOwned = 0;
+        if (__atomic_compare_exchange_n(&_NetLib_PrintfAsync.aRings[iRing].iOwned, &iOwned, 1, FALSE,
+                __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        {
+            pRing = _NetLib_pPrintfRing = &_NetLib_PrintfAsync.aRings[iRing];
+            pthread_setspecific(_NetLib_PrintfAsync.RingKey, pRing);
+        }
+    }
+    if (pRing == NULL)
+    {
+        // announced like a ring write, so NetPrintfAsyncStop() reports the drop
+        __atomic_add_fetch(&_NetLib_PrintfAsync.iDropping, 1, __ATOMIC_SEQ_CST);
+        if (!__atomic_load_n(&_NetLib_PrintfAsync.iRunning, __ATOMIC_SEQ_CST))
+        {
+            __atomic_sub_fetch(&_NetLib_PrintfAsync.iDropping, 1, __ATOMIC_RELEASE);
+            return(FALSE);
+        }
+        __atomic_add_fetch(&_NetLib_PrintfAsync.uDropped, 1, __ATOMIC_RELAXED);
+        __atomic_sub_fetch(&_NetLib_PrintfAsync.iDropping, 1, __ATOMIC_RELEASE);
+        return(TRUE);
+    }
+
+    /* announce the write before checking that async output is still running;
+       pairs with NetPrintfAsyncStop() */
+    __atomic_store_n(&pRing->iWriting, 1, __ATOMIC_SEQ_CST);
+    if (!__atomic_load_n(&_NetLib_PrintfAsync.iRunning, __ATOMIC_SEQ_CST))
+    {
+        __atomic_store_n(&pRing->iWriting, 0, __ATOMIC_RELEASE);
+        return(FALSE);
+    }
+
+    // records are a length word and the text, padded to a word; a record never wraps
+    uHead = pRing->uHead;
+    uOffset = uHead & (NETPRINTF_RINGSIZE-1);
+    uSize = (sizeof(uint32_t) + iLength + 3) & ~3;
+    uContig = NETPRINTF_RINGSIZE - uOffset;
+    uNeed = (uContig < uSize) ? uContig + uSize : uSize;
+    if ((NETPRINTF_RINGSIZE - (uHead - __atomic_load_n(&pRing->uTail, __ATOMIC_ACQUIRE))) < uNeed)
+    {
+        __atomic_store_n(&pRing->uDropped, pRing->uDropped + 1, __ATOMIC_RELAXED);
+    }
+    else
+    {
+        if (uContig < uSize)
+        {
+            uLength = NETPRINTF_RINGWRAP;
+            memcpy(pRing->aData + uOffset, &uLength, sizeof(uLength));
+            uHead += uContig;
+            uOffset = 0;
+        }
+        uLength = (uint32_t)iLength | uFlag;
+        memcpy(pRing->aData + uOffset, &uLength, sizeof(uLength));
+        memcpy(pRing->aData + uOffset + sizeof(uint32_t), pData, iLength);
+        __atomic_store_n(&pRing->uHead, uHead + uSize, __ATOMIC_RELEASE);
+    }
+    __atomic_store_n(&pRing->iWriting, 0, __ATOMIC_RELEASE);
+    return(TRUE);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _NetPrintfRingDrain
+
+    \Description
+        Write every queued line in every ring to the sink.
+
+    \Output
+        int32_t     - number of lines written
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static int32_t _NetPrintfRingDrain(void)
+{
+    char strText[NETPRINTF_MAXTEXT+1];
+    uint32_t uHead, uTail, uOffset, uLength, uFlag, uDropped;
+    int32_t iRing, iLines = 0;
+
+    for (iRing = 0; iRing < NETPRINTF_RINGS; iRing += 1)
+    {
+        NetPrintfRingT *pRing = &_NetLib_PrintfAsync.aRings[iRing];
+
+        uHead = __atomic_load_n(&pRing->uHead, __ATOMIC_ACQUIRE);
+        for (uTail = pRing->uTail; uTail != uHead; )
+        {
+            uOffset = uTail & (NETPRINTF_RINGSIZE-1);
+            memcpy(&uLength, pRing->aData + uOffset, sizeof(uLength));
+            if (uLength == NETPRINTF_RINGWRAP)
+            {
+                uTail += NETPRINTF_RINGSIZE - uOffset;
+                continue;
+            }
+            uFlag = uLength & NETPRINTF_RINGBIN;
+            uLength &= ~NETPRINTF_RINGBIN;
+            memcpy(strText, pRing->aData + uOffset + sizeof(uint32_t), uLength);
+            strText[uLength] = '\0';
+            uTail += (sizeof(uint32_t) + uLength + 3) & ~3;
+            // free the space before writing, so the producer can reuse it sooner
+            __atomic_store_n(&pRing->uTail, uTail, __ATOMIC_RELEASE);
+            if (uFlag)
+            {
+                _NetPrintfBinWrite(strText, (int32_t)uLength);
+            }
+            else
+            {
+                _NetPrintfWrite(strText);
+            }
+            iLines += 1;
+        }
+
+        if ((uDropped = __atomic_load_n(&pRing->uDropped, __ATOMIC_RELAXED)) != pRing->uDropReported)
+        {
+            snprintf(strText, sizeof(strText), "dirtylib: dropped %u lines of debug output\n",
+                uDropped - pRing->uDropReported);
+            pRing->uDropReported = uDropped;
+            _NetPrintfWrite(strText);
+        }
+    }
+
+    uDropped = __atomic_load_n(&_NetLib_PrintfAsync.uDropped, __ATOMIC_RELAXED);
+    if (uDropped != _NetLib_PrintfAsync.uDropReported)
+    {
+        snprintf(strText, sizeof(strText), "dirtylib: dropped %u lines of debug output"
+            " from threads without a ring\n", uDropped - _NetLib_PrintfAsync.uDropReported);
+        _NetLib_PrintfAsync.uDropReported = uDropped;
+        _NetPrintfWrite(strText);
+    }
+    return(iLines);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _NetPrintfText
+
+    \Description
+        Format a line of debug output and send it to the sink, or queue it for the
+        background thread if async output is running.
+
+    \Input *pFormat     - format string
+    \Input Args         - format arguments
+
+    \Output
+        int32_t         - length of the formatted text
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static int32_t _NetPrintfText(const char *pFormat, va_list Args)
+{
+    char strText[NETPRINTF_MAXTEXT];
+    int32_t iLength;
+
+    iLength = vsnprintf(strText, sizeof(strText), pFormat, Args);
+    if (iLength >= (int32_t)sizeof(strText))
+    {
+        iLength = sizeof(strText) - 1;
+    }
+
+    if (!__atomic_load_n(&_NetLib_PrintfAsync.iRunning, __ATOMIC_RELAXED) ||
+        !_NetPrintfRingPut(strText, iLength, 0))
+    {
+        _NetPrintfWrite(strText);
+    }
+    return(iLength);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _NetPrintfBinOutput
+
+    \Description
+        Send a binary record to the binary sink, or queue it for the background
+        thread if async output is running.
+
+    \Input *pData   - record
+    \Input iLength  - record length
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static void _NetPrintfBinOutput(const void *pData, int32_t iLength)
+{
+    if (!__atomic_load_n(&_NetLib_PrintfAsync.iRunning, __ATOMIC_RELAXED) ||
+        !_NetPrintfRingPut(pData, iLength, NETPRINTF_RINGBIN))
+    {
+        _NetPrintfBinWrite(pData, iLength);
+    }
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _NetPrintfBinSpec
+
+    \Description
+        Find the next conversion in a format string and classify its argument.
+
+    \Input **ppFormat   - [in/out] format position; advanced past the conversion
+    \Input **ppSpec     - [out] start of the conversion ('%')
+
+    \Output
+        int32_t         - argument type: 'i' int, 'l' long, 'q' long long, 'd' double,
+                          'p' pointer, 's' string, '%' for "%%" (no argument), zero at the
+                          end of the format, negative if the conversion is not supported
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static int32_t _NetPrintfBinSpec(const char **ppFormat, const char **ppSpec)
+{
+    const char *pFormat = *ppFormat;
+    int32_t iLong = 0;
+
+    while ((*pFormat != '\0') && (*pFormat != '%'))
+    {
+        pFormat += 1;
+    }
+    *ppSpec = pFormat;
+    if (*pFormat == '\0')
+    {
+        *ppFormat = pFormat;
+        return(0);
+    }
+    if (*++pFormat == '%')
+    {
+        *ppFormat = pFormat + 1;
+        return('%');
+    }
+
+    // flags, width and precision; '*' would need an extra argument
+    while ((*pFormat != '\0') && (strchr("-+ #0'", *pFormat) != NULL))
+    {
+        pFormat += 1;
+    }
+    while (((*pFormat >= '0') && (*pFormat <= '9')) || (*pFormat == '.'))
+    {
+        pFormat += 1;
+    }
+
+    // length modifier
+    if ((pFormat[0] == 'h') || (pFormat[0] == 'l'))
+    {
+        iLong = (pFormat[0] == 'l') ? 1 : 0;
+        if (pFormat[1] == pFormat[0])
+        {
+            iLong *= 2;
+            pFormat += 1;
+        }
+        pFormat += 1;
+    }
+    else if ((*pFormat == 'z') || (*pFormat == 't'))
+    {
+        iLong = (sizeof(size_t) == sizeof(int32_t)) ? 0 : 2;
+        pFormat += 1;
+    }
+    else if (*pFormat == 'j')
+    {
+        iLong = 2;
+        pFormat += 1;
+    }
+
+    *ppFormat = pFormat + 1;
+    switch (*pFormat)
+    {
+        case 'd': case 'i': case 'u': case 'x': case 'X': case 'o':
+            return((iLong == 0) ? 'i' : ((iLong == 1) ? 'l' : 'q'));
+        case 'c':
+            return((iLong == 0) ? 'i' : -1);
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            return('d');
+        case 'p':
+            return('p');
+        case 's':
+            return((iLong == 0) ? 's' : -1);
+        default:
+            *ppFormat = pFormat;
+            return(-1);
+    }
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _NetPrintfBinIntern
+
+    \Description
+        Return the format id of a call site, interning the format on first use and
+        sending its definition record to the current binary sink if it has not
+        been sent there yet.
+
+    \Input *pFmtId      - call site format id (zero=not interned yet, negative=text only)
+    \Input *pFormat     - format string
+
+    \Output
+        int32_t         - format id, or negative to log the call site as text
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static int32_t _NetPrintfBinIntern(int32_t *pFmtId, const char *pFormat)
+{
+    uint8_t aRecord[NETPRINTF_MAXTEXT];
+    NetPrintfBinFmtT *pBinFmt;
+    const char *pParse, *pSpec;
+    int32_t iFmtId, iNewId, iType, iNumArgs, iGeneration, iLength;
+    uint64_t uTime;
+    uint16_t uWord;
+
+    if ((iFmtId = __atomic_load_n(pFmtId, __ATOMIC_ACQUIRE)) == 0)
+    {
+        // parse into a new slot; if another thread interns the site first, its id wins
+        iNewId = __atomic_add_fetch(&_NetLib_iBinFormats, 1, __ATOMIC_RELAXED);
+        if (iNewId >= NETPRINTF_BINFORMATS)
+        {
+            iNewId = -1;
+        }
+        else
+        {
+            pBinFmt = &_NetLib_aBinFormats[iNewId];
+            for (iNumArgs = 0, pParse = pFormat; (iType = _NetPrintfBinSpec(&pParse, &pSpec)) != 0; )
+            {
+                if ((iType < 0) || (iNumArgs == NETPRINTF_BINMAXARGS))
+                {
+                    iNewId = -1;
+                    break;
+                }
+                if (iType != '%')
+                {
+                    pBinFmt->strTypes[iNumArgs++] = (char)iType;
+                }
+            }
+            pBinFmt->strTypes[iNumArgs] = '\0';
+        }
+        __atomic_compare_exchange_n(pFmtId, &iFmtId, iNewId, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+        iFmtId = (iFmtId != 0) ? iFmtId : iNewId;
+    }
+    if (iFmtId < 0)
+    {
+        return(iFmtId);
+    }
+
+    /* define the format to this sink: the new id, then the format text. the generation
+       is published only once the definition is out, so a thread racing on the same site
+       may send a duplicate definition but never a synchronous record ahead of it */
+    pBinFmt = &_NetLib_aBinFormats[iFmtId];
+    iGeneration = __atomic_load_n(&_NetLib_iBinGeneration, __ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&pBinFmt->iGeneration, __ATOMIC_ACQUIRE) != iGeneration)
+    {
+        iLength = (int32_t)strlen(pFormat);
+        if (iLength > (int32_t)(sizeof(aRecord) - NETPRINTF_BINHEADER - 2))
+        {
+            iLength = (int32_t)(sizeof(aRecord) - NETPRINTF_BINHEADER - 2);
+        }
+        uTime = NetTickUsec();
+        uWord = 0;
+        memcpy(aRecord, &uWord, 2);
+        uWord = (uint16_t)(iLength + 2);
+        memcpy(aRecord + 2, &uWord, 2);
+        memcpy(aRecord + 4, &uTime, 8);
+        uWord = (uint16_t)iFmtId;
+        memcpy(aRecord + NETPRINTF_BINHEADER, &uWord, 2);
+        memcpy(aRecord + NETPRINTF_BINHEADER + 2, pFormat, iLength);
+        _NetPrintfBinOutput(aRecord, NETPRINTF_BINHEADER + 2 + iLength);
+        __atomic_store_n(&pBinFmt->iGeneration, iGeneration, __ATOMIC_RELEASE);
+    }
+    return(iFmtId);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _NetPrintfBinRecord
+
+    \Description
+        Build and send a binary record: format id, payload length, timestamp, then
+        each argument in its raw form. Strings are stored as a 16-bit length and
+        their bytes, truncated to fit the record.
+
+    \Input iFmtId       - format id
+    \Input Args         - format arguments
+
+    \Output
+        int32_t         - record length
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static int32_t _NetPrintfBinRecord(int32_t iFmtId, va_list Args)
+{
+    uint8_t aRecord[NETPRINTF_MAXTEXT];
+    const char *pTypes, *pString;
+    int32_t iOffset = NETPRINTF_BINHEADER, iInt, iLength;
+    int64_t iLong;
+    uint64_t uTime, uPtr;
+    uint16_t uWord;
+    double fDouble;
+
+    // the arguments (at most 16 of 8 bytes) always fit; strings get what is left
+    for (pTypes = _NetLib_aBinFormats[iFmtId].strTypes; *pTypes != '\0'; pTypes += 1)
+    {
+        switch (*pTypes)
+        {
+            case 'i':
+                iInt = va_arg(Args, int);
+                memcpy(aRecord + iOffset, &iInt, 4);
+                iOffset += 4;
+                break;
+            case 'l':
+                iLong = va_arg(Args, long);
+                memcpy(aRecord + iOffset, &iLong, 8);
+                iOffset += 8;
+                break;
+            case 'q':
+                iLong = va_arg(Args, long long);
+                memcpy(aRecord + iOffset, &iLong, 8);
+                iOffset += 8;
+                break;
+            case 'd':
+                fDouble = va_arg(Args, double);
+                memcpy(aRecord + iOffset, &fDouble, 8);
+                iOffset += 8;
+                break;
+            case 'p':
+                uPtr = (uint64_t)(uintptr_t)va_arg(Args, void *);
+                memcpy(aRecord + iOffset, &uPtr, 8);
+                iOffset += 8;
+                break;
+            case 's':
+                if ((pString = va_arg(Args, const char *)) == NULL)
+                {
+                    pString = "(null)";
+                }
+                iLength = (int32_t)strlen(pString);
+                if (iLength > (int32_t)(sizeof(aRecord) - iOffset - 2 - (NETPRINTF_BINMAXARGS * 8)))
+                {
+                    iLength = (int32_t)(sizeof(aRecord) - iOffset - 2 - (NETPRINTF_BINMAXARGS * 8));
+                }
+                iLength = (iLength > 0) ? iLength : 0;
+                uWord = (uint16_t)iLength;
+                memcpy(aRecord + iOffset, &uWord, 2);
+                memcpy(aRecord + iOffset + 2, pString, iLength);
+                iOffset += 2 + iLength;
+                break;
+        }
+    }
+
+    uWord = (uint16_t)iFmtId;
+    memcpy(aRecord, &uWord, 2);
+    uWord = (uint16_t)(iOffset - NETPRINTF_BINHEADER);
+    memcpy(aRecord + 2, &uWord, 2);
+    uTime = NetTickUsec();
+    memcpy(aRecord + 4, &uTime, 8);
+    _NetPrintfBinOutput(aRecord, iOffset);
+    return(iOffset);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _NetPrintfAsyncThread
+
+    \Description
+        Background thread that drains the rings until told to stop.
+
+    \Input *pArg    - unused
+
+    \Output
+        void *      - unused
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static void *_NetPrintfAsyncThread(void *pArg)
+{
+    struct timespec Sleep = { 0, 1000000 };
+
+    while (!__atomic_load_n(&_NetLib_PrintfAsync.iStop, __ATOMIC_ACQUIRE))
+    {
+        if (_NetPrintfRingDrain() == 0)
+        {
+            nanosleep(&Sleep, NULL);
+        }
+    }
+    _NetPrintfRingDrain();
+    return(NULL);
+}
+#endif // DIRTYCODE_LOGGING
+
+/*** Public Functions *************************************************************/
+
+/*F********************************************************************************/
+/*!
+    \Function NetTickUsec
+
+    \Description
+        Return an increasing tick count with microsecond scale.
+
+    \Output
+        uint64_t    - microseconds since an arbitrary fixed point; does not wrap
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+uint64_t NetTickUsec(void)
+{
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+    return((uint64_t)Now.tv_sec * 1000000 + (uint64_t)Now.tv_nsec / 1000);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function NetTick64
+
+    \Description
+        Return an increasing tick count with millisecond scale.
+
+    \Output
+        uint64_t    - milliseconds since an arbitrary fixed point; does not wrap
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+uint64_t NetTick64(void)
+{
+    return(NetTickUsec() / 1000);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function NetTick
+
+    \Description
+        Return an increasing tick count with millisecond scale.
+
+    \Output
+        uint32_t    - low 32 bits of NetTick64(); compare values with NetTickDiff()
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+uint32_t NetTick(void)
+{
+    return((uint32_t)NetTick64());
+}
+
+/*F********************************************************************************/
+/*!
+    \Function NetTickUpdate
+
+    \Description
+        Refresh the process-wide cached coarse tick. If threads update concurrently
+        the latest reading wins, so the coarse tick never goes backwards.
+
+    \Output
+        uint64_t    - the new NetTickCoarseUsec() value
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+uint64_t NetTickUpdate(void)
+{
+    uint64_t uNow = NetTickUsec(), uCoarse = __atomic_load_n(&_NetLib_uCoarseUsec, __ATOMIC_RELAXED);
+
+    while (uCoarse < uNow)
+    {
+        if (__atomic_compare_exchange_n(&_NetLib_uCoarseUsec, &uCoarse, uNow, TRUE,
+                __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        {
+            return(uNow);
+        }
+    }
+    return(uCoarse);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function NetTickCoarseUsec
+
+    \Description
+        Return the tick cached by the last NetTickUpdate() from any thread, reading
+        the clock if there has been no update yet.
+
+    \Output
+        uint64_t    - cached microsecond tick
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+uint64_t NetTickCoarseUsec(void)
+{
+    uint64_t uCoarse = __atomic_load_n(&_NetLib_uCoarseUsec, __ATOMIC_RELAXED);
+    return((uCoarse != 0) ? uCoarse : NetTickUpdate());
+}
+
+#if defined(__linux__)
+/*F********************************************************************************/
+/*!
+    \Function NetCritInit
+
+    \Description
+        Initialize a critical section for use.
+
+    \Input *pCrit      - critical section
+    \Input *pCritName  - critical section name, for debugging
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+void NetCritInit(NetCritT *pCrit, const char *pCritName)
+{
+    memset(pCrit, 0, sizeof(*pCrit));
+    #if DIRTYCODE_CRITSTATS
+    _NetCritStatRegister((NetCritFutexT *)pCrit->data, pCritName);
+    #endif
+}
+
+/*F********************************************************************************/
+/*!
+    \Function NetCritKill
+
+    \Description
+        Release resources and destroy a critical section.
+
+    \Input *pCrit      - critical section
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+void NetCritKill(NetCritT *pCrit)
+{
+    #if DIRTYCODE_CRITSTATS
+    NetCritFutexT *pFutex = (NetCritFutexT *)pCrit->data;
+    if (pFutex->iStat != 0)
+    {
+        __atomic_store_n(&_NetLib_aCritStats[pFutex->iStat - 1].pOwner, NULL, __ATOMIC_RELAXED);
+        __atomic_store_n(&_NetLib_aCritStats[pFutex->iStat - 1].iUsed, 0, __ATOMIC_RELEASE);
+        pFutex->iStat = 0;
+    }
+    #endif
+}
+
+/*F********************************************************************************/
+/*!
+    \Function NetCritTry
+
+    \Description
+        Attempt to gain access to a critical section without blocking.
+
+    \Input *pCrit      - critical section
+
+    \Output
+        int32_t         - TRUE if access was gained, else FALSE
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+int32_t NetCritTry(NetCritT *pCrit)
+{
+    NetCritFutexT *pFutex = (NetCritFutexT *)pCrit->data;
+    int32_t iSelf = _NetCritThreadId(), iState = NETCRIT_UNLOCKED;
+
+    if (__atomic_load_n(&pFutex->iOwner, __ATOMIC_RELAXED) == iSelf)
+    {
+        pFutex->iDepth += 1;
+        return(TRUE);
+    }
+    if (!__atomic_compare_exchange_n(&pFutex->iState, &iState, NETCRIT_LOCKED, FALSE,
+            __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+        #if DIRTYCODE_CRITSTATS
+        if (pFutex->iStat != 0)
+        {
+            __atomic_fetch_add(&_NetLib_aCritStats[pFutex->iStat - 1].Stat.uTryFails, 1, __ATOMIC_RELAXED);
+        }
+        #endif
+        return(FALSE);
+    }
+    _NetCritAcquired(pFutex, iSelf);
+    #if DIRTYCODE_CRITSTATS
+    _NetCritStatAcquired(pFutex, _NetCritStatSample(pFutex), FALSE, 0, __builtin_return_address(0));
+    #endif
+    return(TRUE);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function NetCritEnter
+
+    \Description
+        Enter a critical section, blocking if needed.
+
+    \Input *pCrit      - critical section
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+void NetCritEnter(NetCritT *pCrit)
+{
+    NetCritFutexT *pFutex = (NetCritFutexT *)pCrit->data;
+    int32_t iSelf = _NetCritThreadId(), iState = NETCRIT_UNLOCKED;
+    #if DIRTYCODE_CRITSTATS
+    uint32_t bSampled, bContended = FALSE;
+    uint64_t uWaitStart = 0;
+    #endif
+
+    // only this thread can have stored its own id, so a relaxed read is enough
+    if (__atomic_load_n(&pFutex->iOwner, __ATOMIC_RELAXED) == iSelf)
+    {
+        pFutex->iDepth += 1;
+        return;
+    }
+    #if DIRTYCODE_CRITSTATS
+    bSampled = _NetCritStatSample(pFutex);
+    #endif
+    if (!__atomic_compare_exchange_n(&pFutex->iState, &iState, NETCRIT_LOCKED, FALSE,
+            __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+        #if DIRTYCODE_CRITSTATS
+        bContended = TRUE;
+        uWaitStart = bSampled ? _NetCritStatNsec() : 0;
+        #endif
+        _NetCritWait(pFutex);
+    }
+    _NetCritAcquired(pFutex, iSelf);
+    #if DIRTYCODE_CRITSTATS
+    _NetCritStatAcquired(pFutex, bSampled, bContended, uWaitStart, __builtin_return_address(0));
+    #endif
+}
+
+/*F********************************************************************************/
+/*!
+    \Function NetCritLeave
+
+    \Description
+        Leave a critical section.
+
+    \Input *pCrit      - critical section
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+void NetCritLeave(NetCritT *pCrit)
+{
+    NetCritFutexT *pFutex = (NetCritFutexT *)pCrit->data;
+
+    if (--pFutex->iDepth > 0)
+    {
+        return;
+    }
+    #if DIRTYCODE_CRITSTATS
+    _NetCritStatReleased(pFutex);
+    #endif
+    __atomic_store_n(&pFutex->iOwner, 0, __ATOMIC_RELAXED);
+    if (__atomic_exchange_n(&pFutex->iState, NETCRIT_UNLOCKED, __ATOMIC_RELEASE) == NETCRIT_CONTENDED)
+    {
+        syscall(SYS_futex, &pFutex->iState, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+    }
+}
+
+#if DIRTYCODE_CRITSTATS
+/*F********************************************************************************/
+/*!
+    \Function NetCritStatControl
+
+    \Description
+        Set how often acquisitions are timed. Counts are kept regardless.
+
+    \Input uSampleRate  - time one in uSampleRate acquisitions per thread (zero=none)
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+void NetCritStatControl(uint32_t uSampleRate)
+{
+    __atomic_store_n(&_NetLib_uCritSampleRate, uSampleRate, __ATOMIC_RELAXED);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function NetCritStatGet
+
+    \Description
+        Get contention statistics for the first profiled critical section with the
+        given name. The copy is taken without locking, so counters may be slightly
+        out of step with each other.
+
+    \Input *pCritName   - critical section name
+    \Input *pStat       - [out] statistics
+
+    \Output
+        int32_t         - zero=success, negative=no such critical section
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+int32_t NetCritStatGet(const char *pCritName, NetCritStatT *pStat)
+{
+    int32_t iSlot;
+
+    for (iSlot = 0; iSlot < NETCRIT_STATMAX; iSlot += 1)
+    {
+        NetCritStatEntryT *pEntry = &_NetLib_aCritStats[iSlot];
+        if (__atomic_load_n(&pEntry->iUsed, __ATOMIC_ACQUIRE) && !strcmp(pEntry->Stat.strName, pCritName))
+        {
+            memcpy(pStat, &pEntry->Stat, sizeof(*pStat));
+            return(0);
+        }
+    }
+    return(-1);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function NetCritStatReport
+
+    \Description
+        Report counts, wait and hold histograms and the longest sampled holder of
+        every profiled critical section.
+
+    \Input *pBuffer     - output buffer, or NULL to send the report to debug output
+    \Input iBufSize     - size of output buffer
+
+    \Output
+        int32_t         - length of the full report; the buffer holds only the lines that fit
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+int32_t NetCritStatReport(char *pBuffer, int32_t iBufSize)
+{
+    NetCritStatReportT Report;
+    NetCritStatT Stat;
+    int32_t iSlot, iBucket;
+
+    Report.pBuffer = pBuffer;
+    Report.iBufSize = iBufSize;
+    Report.iLength = 0;
+    if ((pBuffer != NULL) && (iBufSize > 0))
+    {
+        pBuffer[0] = '\0';
+    }
+
+    _NetCritStatPrintf(&Report, "netcrit: contention report"
+        " (wait/hold buckets <256ns <1us <4us <16us <64us <256us <1ms >=1ms)\n");
+    for (iSlot = 0; iSlot < NETCRIT_STATMAX; iSlot += 1)
+    {
+        NetCritStatEntryT *pEntry = &_NetLib_aCritStats[iSlot];
+        if (!__atomic_load_n(&pEntry->iUsed, __ATOMIC_ACQUIRE))
+        {
+            continue;
+        }
+        memcpy(&Stat, &pEntry->Stat, sizeof(Stat));
+        _NetCritStatPrintf(&Report, "  '%s' acquires %u contended %u (%.1f%%) try fails %u sampled %u"
+            " longest hold %llu ns by thread %d at %p\n",
+            Stat.strName, Stat.uAcquires, Stat.uContended,
+            (Stat.uAcquires != 0) ? 100.0 * Stat.uContended / Stat.uAcquires : 0.0, Stat.uTryFails, Stat.uSampled,
+            (unsigned long long)Stat.uMaxHoldNs, Stat.iMaxHoldThread, Stat.pMaxHoldCaller);
+        _NetCritStatPrintf(&Report, "    wait");
+        for (iBucket = 0; iBucket < NETCRIT_HISTBUCKETS; iBucket += 1)
+        {
+            _NetCritStatPrintf(&Report, " %u", Stat.aWaitHist[iBucket]);
+        }
+        _NetCritStatPrintf(&Report, "\n    hold");
+        for (iBucket = 0; iBucket < NETCRIT_HISTBUCKETS; iBucket += 1)
+        {
+            _NetCritStatPrintf(&Report, " %u", Stat.aHoldHist[iBucket]);
+        }
+        _NetCritStatPrintf(&Report, "\n");
+    }
+    return(Report.iLength);
+}
+#endif // DIRTYCODE_CRITSTATS
+#else
+/*F********************************************************************************/
+/*!
+    \Function NetCritInit
+
+    \Description
+        Initialize a critical section for use.
+
+    \Input *pCrit      - critical section
+    \Input *pCritName  - critical section name, for debugging
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+void NetCritInit(NetCritT *pCrit, const char *pCritName)
+{
+    pthread_mutexattr_t Attr;
+
+    pthread_mutexattr_init(&Attr);
+    pthread_mutexattr_settype(&Attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init((pthread_mutex_t *)pCrit->data, &Attr);
+    pthread_mutexattr_destroy(&Attr);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function NetCritKill
+
+    \Description
+        Release resources and destroy a critical section.
+
+    \Input *pCrit      - critical section
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+void NetCritKill(NetCritT *pCrit)
+{
+    pthread_mutex_destroy((pthread_mutex_t *)pCrit->data);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function NetCritTry
+
+    \Description
+        Attempt to gain access to a critical section without blocking.
+
+    \Input *pCrit      - critical section
+
+    \Output
+        int32_t         - TRUE if access was gained, else FALSE
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+int32_t NetCritTry(NetCritT *pCrit)
+{
+    return(pthread_mutex_trylock((pthread_mutex_t *)pCrit->data) == 0);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function NetCritEnter
+
+    \Description
+        Enter a critical section, blocking if needed.
+
+    \Input *pCrit      - critical section
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+void NetCritEnter(NetCritT *pCrit)
+{
+    pthread_mutex_lock((pthread_mutex_t *)pCrit->data);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function NetCritLeave
+
+    \Description
+        Leave a critical section.
+
+    \Input *pCrit      - critical section
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+void NetCritLeave(NetCritT *pCrit)
+{
+    pthread_mutex_unlock((pthread_mutex_t *)pCrit->data);
+}
+#endif
+
+#if DIRTYCODE_LOGGING
+/*F********************************************************************************/
+/*!
+    \Function NetPrintfHook
+
+    \Description
+        Hook into debug output. While async output is running the hook is called
+        from the background thread.
+
+    \Input *pPrintfDebugHook    - sink for debug output, or NULL for stdout
+    \Input *pParm               - user parameter passed to the hook
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+void NetPrintfHook(int32_t (*pPrintfDebugHook)(void *pParm, const char *pText), void *pParm)
+{
+    _NetLib_pDebugParm = pParm;
+    _NetLib_pDebugHook = pPrintfDebugHook;
+}
+
+/*F********************************************************************************/
+/*!
+    \Function NetPrintfCode
+
+    \Description
+        Format a line of debug output and send it to the sink, or queue it for the
+        background thread if async output is running.
+
+    \Input *pFormat     - format string
+
+    \Output
+        int32_t         - length of the formatted text
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+int32_t NetPrintfCode(const char *pFormat, ...)
+{
+    int32_t iLength;
+    va_list Args;
+
+    va_start(Args, pFormat);
+    iLength = _NetPrintfText(pFormat, Args);
+    va_end(Args);
+    return(iLength);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function NetPrintfBinCode
+
+    \Description
+        Log a call site as a binary record if a binary sink is set, else as text.
+
+    \Input *pFmtId      - call site format id storage, zero-initialized
+    \Input *pFormat     - format string; must stay valid and unchanged for the call site
+
+    \Output
+        int32_t         - length of the text or record
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+int32_t NetPrintfBinCode(int32_t *pFmtId, const char *pFormat, ...)
+{
+    int32_t iFmtId, iLength;
+    va_list Args;
+
+    va_start(Args, pFormat);
+    if ((_NetLib_pBinHook == NULL) || ((iFmtId = _NetPrintfBinIntern(pFmtId, pFormat)) < 0))
+    {
+        iLength = _NetPrintfText(pFormat, Args);
+    }
+    else
+    {
+        iLength = _NetPrintfBinRecord(iFmtId, Args);
+    }
+    va_end(Args);
+    return(iLength);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function NetPrintfBinHook
+
+    \Description
+        Send debug output from NetPrintfBinCode() call sites to a binary sink, or
+        back to text if the hook is NULL. Each new sink receives the definition of
+        a format before its first record. While async output is running the hook is
+        called from the background thread, and records already queued are written
+        to the old sink before the new one takes over.
+
+    \Input *pBinHook    - binary sink, or NULL for text output
+    \Input *pParm       - user parameter passed to the hook
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+void NetPrintfBinHook(int32_t (*pBinHook)(void *pParm, const void *pData, int32_t iLength), void *pParm)
+{
+    int32_t iRunning = __atomic_load_n(&_NetLib_PrintfAsync.iRunning, __ATOMIC_ACQUIRE);
+
+    // queued records were defined to the old sink; stopping drains them there
+    if (iRunning)
+    {
+        NetPrintfAsyncStop();
+    }
+    _NetLib_pBinParm = pParm;
+    __atomic_add_fetch(&_NetLib_iBinGeneration, 1, __ATOMIC_ACQ_REL);
+    _NetLib_pBinHook = pBinHook;
+    if (iRunning)
+    {
+        NetPrintfAsyncStart();
+    }
+}
+
+/*F********************************************************************************/
+/*!
+    \Function NetPrintfBinRender
+
+    \Description
+        Render the arguments of a binary record as text with its format.
+
+    \Input *pFormat     - format string from the record's definition
+    \Input *pArgs       - record payload
+    \Input iArgLen      - payload length
+    \Input *pBuffer     - [out] text buffer
+    \Input iBufSize     - size of text buffer
+
+    \Output
+        int32_t         - length of the text, or negative if the payload does not match the format
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+int32_t NetPrintfBinRender(const char *pFormat, const uint8_t *pArgs, int32_t iArgLen, char *pBuffer, int32_t iBufSize)
+{
+    char strSpec[32], strString[NETPRINTF_MAXTEXT];
+    const char *pSpec, *pLiteral = pFormat;
+    int32_t iType, iInt, iLength = 0, iOffset = 0, iSpecLen, iArgSize;
+    int64_t iLong;
+    uint64_t uPtr;
+    uint16_t uWord;
+    double fDouble;
+
+    if (iBufSize <= 0)
+    {
+        return(-1);
+    }
+    pBuffer[0] = '\0';
+    for (;;)
+    {
+        iType = _NetPrintfBinSpec(&pFormat, &pSpec);
+
+        // literal text up to the conversion
+        iSpecLen = (int32_t)(pSpec - pLiteral);
+        iSpecLen = ((iLength + iSpecLen) < iBufSize) ? iSpecLen : (iBufSize - iLength - 1);
+        memcpy(pBuffer + iLength, pLiteral, iSpecLen);
+        iLength += iSpecLen;
+        pBuffer[iLength] = '\0';
+        pLiteral = pFormat;
+        if ((iType <= 0) || ((iSpecLen = (int32_t)(pFormat - pSpec)) >= (int32_t)sizeof(strSpec)))
+        {
+            return(((iType == 0) && (iOffset == iArgLen)) ? iLength : -1);
+        }
+        memcpy(strSpec, pSpec, iSpecLen);
+        strSpec[iSpecLen] = '\0';
+
+        // the argument, formatted with its own conversion
+        iArgSize = (iType == 'i') ? 4 : ((iType == 's') ? 2 : ((iType == '%') ? 0 : 8));
+        if ((iOffset + iArgSize) > iArgLen)
+        {
+            return(-1);
+        }
+        switch (iType)
+        {
+            case '%':
+                iSpecLen = snprintf(pBuffer + iLength, iBufSize - iLength, "%%");
+                break;
+            case 'i':
+                memcpy(&iInt, pArgs + iOffset, 4);
+                iSpecLen = snprintf(pBuffer + iLength, iBufSize - iLength, strSpec, iInt);
+                break;
+            case 'l':
+                memcpy(&iLong, pArgs + iOffset, 8);
+                iSpecLen = snprintf(pBuffer + iLength, iBufSize - iLength, strSpec, (long)iLong);
+                break;
+            case 'q':
+                memcpy(&iLong, pArgs + iOffset, 8);
+                iSpecLen = snprintf(pBuffer + iLength, iBufSize - iLength, strSpec, (long long)iLong);
+                break;
+            case 'd':
+                memcpy(&fDouble, pArgs + iOffset, 8);
+                iSpecLen = snprintf(pBuffer + iLength, iBufSize - iLength, strSpec, fDouble);
+                break;
+            case 'p':
+                memcpy(&uPtr, pArgs + iOffset, 8);
+                iSpecLen = snprintf(pBuffer + iLength, iBufSize - iLength, strSpec, (void *)(uintptr_t)uPtr);
+                break;
+            case 's':
+                memcpy(&uWord, pArgs + iOffset, 2);
+                if (((iOffset + 2 + uWord) > iArgLen) || (uWord >= sizeof(strString)))
+                {
+                    return(-1);
+                }
+                memcpy(strString, pArgs + iOffset + 2, uWord);
+                strString[uWord] = '\0';
+                iArgSize += uWord;
+                iSpecLen = snprintf(pBuffer + iLength, iBufSize - iLength, strSpec, strString);
+                break;
+        }
+        iOffset += iArgSize;
+        iLength += ((iLength + iSpecLen) < iBufSize) ? iSpecLen : (iBufSize - iLength - 1);
+    }
+}
+
+/*F********************************************************************************/
+/*!
+    \Function NetPrintfAsyncStart
+
+    \Description
+        Start sending debug output from a background thread.
+
+    \Output
+        int32_t     - zero=success, negative=failure
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+int32_t NetPrintfAsyncStart(void)
+{
+    if (_NetLib_PrintfAsync.iRunning)
+    {
+        return(0);
+    }
+    // threads keep their rings across a stop and restart, so the key releasing them outlives both
+    if (!_NetLib_PrintfAsync.bRingKey)
+    {
+        if (pthread_key_create(&_NetLib_PrintfAsync.RingKey, _NetPrintfRingRelease) != 0)
+        {
+            return(-1);
+        }
+        _NetLib_PrintfAsync.bRingKey = TRUE;
+    }
+    _NetLib_PrintfAsync.iStop = 0;
+    if (pthread_create(&_NetLib_PrintfAsync.Thread, NULL, _NetPrintfAsyncThread, NULL) != 0)
+    {
+        return(-1);
+    }
+    __atomic_store_n(&_NetLib_PrintfAsync.iRunning, 1, __ATOMIC_SEQ_CST);
+    return(0);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function NetPrintfAsyncStop
+
+    \Description
+        Write all queued debug output and stop the background thread. Later output
+        is written by the calling thread again.
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+void NetPrintfAsyncStop(void)
+{
+    int32_t iRing;
+
+    if (!_NetLib_PrintfAsync.iRunning)
+    {
+        return;
+    }
+
+    // stop new lines going to the rings, then wait out any line being added
+    __atomic_store_n(&_NetLib_PrintfAsync.iRunning, 0, __ATOMIC_SEQ_CST);
+    for (iRing = 0; iRing < NETPRINTF_RINGS; iRing += 1)
+    {
+        while (__atomic_load_n(&_NetLib_PrintfAsync.aRings[iRing].iWriting, __ATOMIC_SEQ_CST))
+        {
+            NETCRIT_PAUSE();
+        }
+    }
+    while (__atomic_load_n(&_NetLib_PrintfAsync.iDropping, __ATOMIC_SEQ_CST))
+    {
+        NETCRIT_PAUSE();
+    }
+
+    __atomic_store_n(&_NetLib_PrintfAsync.iStop, 1, __ATOMIC_RELEASE);
+    pthread_join(_NetLib_PrintfAsync.Thread, NULL);
+}
+#endif // DIRTYCODE_LOGGING
@@ -0,0 +1,836 @@
+/*H********************************************************************************/
+/*!
+    \File dirtymem.c
+
+    \Description
+        DirtySock memory group tracking and live allocation tracker.
+
+    \Notes
+        The memory group stack is kept per thread, so a thread creating modules
+        in its own group does not affect allocations made concurrently by other
+        threads.
+
+        When DIRTYCODE_MEMTRACK is enabled, DirtyMemDebugAlloc() and
+        DirtyMemDebugFree() record every live allocation in a pointer-keyed hash
+        table split into independently locked stripes. Live and peak bytes and
+        counts are kept once per module memid and once per memory group. The live
+        totals are updated with atomic adds and the peaks with a compare-and-swap
+        max on the new total, so the peaks are true high-water marks and
+        allocations on different stripes still never share a lock. A module or
+        group takes the tracker lock only the first time it allocates, to claim
+        its slot. One in N allocations can also record a short backtrace (Linux
+        only) to show who is holding leaked memory; symbolize the addresses
+        offline with addr2line.
+
+    \Version 10/18/2026 (agent) First Version
+*/
+/********************************************************************************H*/
+
+/*** Include files ****************************************************************/
+
+#include "dirtysock.h"
+#include "dirtymem.h"
+
+#if DIRTYCODE_MEMTRACK
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if DIRTYCODE_PLATFORM == DIRTYCODE_LINUX
+#include <execinfo.h>
+#endif
+#endif
+
+/*** Defines **********************************************************************/
+
+//! maximum memory group nesting depth
+#define DIRTYMEM_MAXGROUPS  (16)
+
+#define DIRTYMEM_TRACK_STRIPES      (16)    //!< independently locked slices of the pointer table
+#define DIRTYMEM_TRACK_MAXKEYS      (128)   //!< accounting slots for modules and for groups
+
+/*! hash buckets per stripe; 16 stripes of 1024 give one entry per bucket at 16K live
+    allocations, beyond which chains grow linearly (8 bytes per bucket) */
+#ifndef DIRTYMEM_TRACK_BUCKETS
+ #define DIRTYMEM_TRACK_BUCKETS     (1024)
+#endif
+#define DIRTYMEM_TRACK_FRAMES       (8)     //!< frames kept per sampled backtrace
+#define DIRTYMEM_TRACK_MAXSAMPLES   (32)    //!< sampled allocations listed in a report
+
+/*** Type Definitions *************************************************************/
+
+//! memory group stack
+typedef struct DirtyMemGroupStackT
+{
+    int32_t iDepth;
+    int32_t iOverflow;          //!< enters dropped because the stack was full; their leaves must not pop
+    int32_t aMemGroup[DIRTYMEM_MAXGROUPS];
+    void *aMemGroupUserData[DIRTYMEM_MAXGROUPS];
+} DirtyMemGroupStackT;
+
+#if DIRTYCODE_MEMTRACK
+//! sampled allocation backtrace
+typedef struct DirtyMemTrackFramesT
+{
+    int32_t iNumFrames;
+    void *aFrames[DIRTYMEM_TRACK_FRAMES];
+} DirtyMemTrackFramesT;
+
+//! one tracked allocation
+typedef struct DirtyMemTrackEntryT
+{
+    struct DirtyMemTrackEntryT *pNext;
+    void *pMem;
+    int32_t iSize;
+    int32_t iMemModule;
+    int32_t iMemGroup;
+    DirtyMemTrackFramesT *pFrames;      //!< backtrace if this allocation was sampled
+} DirtyMemTrackEntryT;
+
+//! accounting slot for a module or group; Stat is updated atomically
+typedef struct DirtyMemTrackKeyT
+{
+    int32_t iKey;
+    uint32_t bUsed;                     //!< set with release order once iKey is written
+    DirtyMemDebugStatT Stat;
+} DirtyMemTrackKeyT;
+
+//! slice of the pointer table with its own lock
+typedef struct DirtyMemTrackStripeT
+{
+    NetCritT Crit;
+    DirtyMemTrackEntryT *pFree;         //!< recycled entries
+    DirtyMemTrackEntryT *aBuckets[DIRTYMEM_TRACK_BUCKETS];
+} DirtyMemTrackStripeT;
+
+//! tracker state
+typedef struct DirtyMemTrackT
+{
+    NetCritT Crit;                      //!< serializes adding keys to the accounting tables
+    uint32_t bActive;
+    uint32_t uSampleRate;
+    DirtyMemTrackKeyT aModules[DIRTYMEM_TRACK_MAXKEYS];
+    DirtyMemTrackKeyT aGroups[DIRTYMEM_TRACK_MAXKEYS];
+    DirtyMemTrackStripeT aStripes[DIRTYMEM_TRACK_STRIPES];
+} DirtyMemTrackT;
+
+//! report output state
+typedef struct DirtyMemTrackReportT
+{
+    char *pBuffer;
+    int32_t iBufSize;
+    int32_t iLength;
+} DirtyMemTrackReportT;
+#endif
+
+/*** Variables ********************************************************************/
+
+//! per-thread memory group stack; depth zero is the default group (zero, no user data)
+static DIRTYCODE_THREADLOCAL DirtyMemGroupStackT _DirtyMem_GroupStack;
+
+#if DIRTYCODE_MEMTRACK
+//! live allocation tracker
+static DirtyMemTrackT _DirtyMem_Track;
+
+//! per-thread allocation counter used for backtrace sampling
+static DIRTYCODE_THREADLOCAL uint32_t _DirtyMem_uTrackSample;
+#endif
+
+/*** Private Functions ************************************************************/
+
+#if DIRTYCODE_MEMTRACK
+/*F********************************************************************************/
+/*!
+    \Function _DirtyMemTrackStripe
+
+    \Description
+        Hash a pointer to its stripe and bucket.
+
+    \Input *pMem        - tracked pointer
+    \Input *pBucket     - [out] bucket index within the stripe
+
+    \Output
+        DirtyMemTrackStripeT *  - stripe holding the pointer
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static DirtyMemTrackStripeT *_DirtyMemTrackStripe(const void *pMem, uint32_t *pBucket)
+{
+    uint32_t uHash = (uint32_t)((uintptr_t)pMem >> 4) * 2654435761u;
+    *pBucket = uHash % DIRTYMEM_TRACK_BUCKETS;
+    return(&_DirtyMem_Track.aStripes[(uHash >> 24) % DIRTYMEM_TRACK_STRIPES]);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _DirtyMemTrackKey
+
+    \Description
+        Find an accounting slot, optionally adding it. Lookups take no lock; adding
+        a key takes the tracker critical section and publishes the slot with
+        release order, so a lookup that finds it also sees its key.
+
+    \Input *pKeys   - accounting table (_DirtyMem_Track.aModules or aGroups)
+    \Input iKey     - module memid or memory group
+    \Input bAdd     - add the key if it is not in the table
+
+    \Output
+        DirtyMemTrackKeyT * - slot, or NULL if not found/table full
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static DirtyMemTrackKeyT *_DirtyMemTrackKey(DirtyMemTrackKeyT *pKeys, int32_t iKey, uint32_t bAdd)
+{
+    DirtyMemTrackKeyT *pKey = NULL;
+    uint32_t uSlot, uProbe, bLocked = FALSE;
+
+    for (uProbe = 0, uSlot = (((uint32_t)iKey * 2654435761u) >> 16) % DIRTYMEM_TRACK_MAXKEYS; uProbe < DIRTYMEM_TRACK_MAXKEYS; )
+    {
+        if (__atomic_load_n(&pKeys[uSlot].bUsed, __ATOMIC_ACQUIRE))
+        {
+            if (pKeys[uSlot].iKey == iKey)
+            {
+                pKey = &pKeys[uSlot];
+                break;
+            }
+            uProbe += 1;
+            uSlot = (uSlot + 1) % DIRTYMEM_TRACK_MAXKEYS;
+            continue;
+        }
+        if (!bAdd)
+        {
+            break;
+        }
+        // empty slot; claim it under the lock, rechecking in case another thread got here first
+        if (!bLocked)
+        {
+            NetCritEnter(&_DirtyMem_Track.Crit);
+            bLocked = TRUE;
+            continue;
+        }
+        pKeys[uSlot].iKey = iKey;
+        __atomic_store_n(&pKeys[uSlot].bUsed, TRUE, __ATOMIC_RELEASE);
+        pKey = &pKeys[uSlot];
+        break;
+    }
+    if (bLocked)
+    {
+        NetCritLeave(&_DirtyMem_Track.Crit);
+    }
+    return(pKey);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _DirtyMemTrackAccount
+
+    \Description
+        Update module and group statistics for an allocation or free. The caller
+        holds the stripe critical section of the pointer, so the alloc and free of
+        one pointer are always accounted in order.
+
+    \Input iMemModule   - module memid
+    \Input iMemGroup    - memory group
+    \Input iSize        - size of the allocation, negative for a free
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static void _DirtyMemTrackAccount(int32_t iMemModule, int32_t iMemGroup, int32_t iSize)
+{
+    DirtyMemTrackKeyT *aKeys[2];
+    int32_t iKey, iCount = (iSize >= 0) ? 1 : -1;
+
+    aKeys[0] = _DirtyMemTrackKey(_DirtyMem_Track.aModules, iMemModule, TRUE);
+    aKeys[1] = _DirtyMemTrackKey(_DirtyMem_Track.aGroups, iMemGroup, TRUE);
+    for (iKey = 0; iKey < 2; iKey += 1)
+    {
+        DirtyMemDebugStatT *pStat;
+        int64_t iLiveBytes, iPeakBytes;
+        int32_t iLiveCount, iPeakCount;
+
+        if (aKeys[iKey] == NULL)
+        {
+            continue;
+        }
+        pStat = &aKeys[iKey]->Stat;
+        iLiveBytes = __atomic_add_fetch(&pStat->iLiveBytes, iSize, __ATOMIC_RELAXED);
+        iLiveCount = __atomic_add_fetch(&pStat->iLiveCount, iCount, __ATOMIC_RELAXED);
+        if (iSize < 0)
+        {
+            continue;
+        }
+        // raise the peaks to the totals this allocation produced
+        for (iPeakBytes = __atomic_load_n(&pStat->iPeakBytes, __ATOMIC_RELAXED); iLiveBytes > iPeakBytes; )
+        {
+            if (__atomic_compare_exchange_n(&pStat->iPeakBytes, &iPeakBytes, iLiveBytes, TRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        for (iPeakCount = __atomic_load_n(&pStat->iPeakCount, __ATOMIC_RELAXED); iLiveCount > iPeakCount; )
+        {
+            if (__atomic_compare_exchange_n(&pStat->iPeakCount, &iPeakCount, iLiveCount, TRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+    }
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _DirtyMemTrackGet
+
+    \Description
+        Read the statistics of a module or group.
+
+    \Input *pKeys   - accounting table (_DirtyMem_Track.aModules or aGroups)
+    \Input iKey     - module memid or memory group
+    \Input *pStat   - [out] statistics
+
+    \Output
+        int32_t     - zero=success, negative=key has not allocated
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static int32_t _DirtyMemTrackGet(DirtyMemTrackKeyT *pKeys, int32_t iKey, DirtyMemDebugStatT *pStat)
+{
+    DirtyMemTrackKeyT *pKey;
+
+    if ((pKey = _DirtyMemTrackKey(pKeys, iKey, FALSE)) == NULL)
+    {
+        memset(pStat, 0, sizeof(*pStat));
+        return(-1);
+    }
+    pStat->iLiveBytes = __atomic_load_n(&pKey->Stat.iLiveBytes, __ATOMIC_RELAXED);
+    pStat->iPeakBytes = __atomic_load_n(&pKey->Stat.iPeakBytes, __ATOMIC_RELAXED);
+    pStat->iLiveCount = __atomic_load_n(&pKey->Stat.iLiveCount, __ATOMIC_RELAXED);
+    pStat->iPeakCount = __atomic_load_n(&pKey->Stat.iPeakCount, __ATOMIC_RELAXED);
+    return(0);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _DirtyMemTrackPrintf
+
+    \Description
+        Append a line to a report buffer, or send it to debug output.
+
+    \Input *pReport - report state
+    \Input *pFormat - format string
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static void _DirtyMemTrackPrintf(DirtyMemTrackReportT *pReport, const char *pFormat, ...)
+{
+    char strLine[256];
+    int32_t iLength;
+    va_list Args;
+
+    va_start(Args, pFormat);
+    iLength = vsnprintf(strLine, sizeof(strLine), pFormat, Args);
+    va_end(Args);
+    if (iLength >= (int32_t)sizeof(strLine))
+    {
+        iLength = sizeof(strLine) - 1;
+    }
+
+    if (pReport->pBuffer == NULL)
+    {
+        NetPrintf(("%s", strLine));
+    }
+    else if ((pReport->iLength + iLength) < pReport->iBufSize)
+    {
+        memcpy(pReport->pBuffer + pReport->iLength, strLine, iLength + 1);
+    }
+    pReport->iLength += iLength;
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _DirtyMemTrackReportKeys
+
+    \Description
+        Add the statistics of one accounting table to a report.
+
+    \Input *pReport - report state
+    \Input *pKeys   - accounting table
+    \Input bModule  - TRUE if the keys are module memids
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static void _DirtyMemTrackReportKeys(DirtyMemTrackReportT *pReport, DirtyMemTrackKeyT *pKeys, uint32_t bModule)
+{
+    DirtyMemDebugStatT Stat;
+    int32_t iKey;
+    for (iKey = 0; iKey < DIRTYMEM_TRACK_MAXKEYS; iKey += 1)
+    {
+        const DirtyMemTrackKeyT *pKey = &pKeys[iKey];
+        if (!__atomic_load_n(&pKey->bUsed, __ATOMIC_ACQUIRE) || (_DirtyMemTrackGet(pKeys, pKey->iKey, &Stat) < 0))
+        {
+            continue;
+        }
+        if ((Stat.iLiveCount == 0) && (Stat.iPeakCount == 0))
+        {
+            continue;
+        }
+        if (bModule)
+        {
+            _DirtyMemTrackPrintf(pReport, "  module '%c%c%c%c'", (pKey->iKey >> 24) & 0xff, (pKey->iKey >> 16) & 0xff, (pKey->iKey >> 8) & 0xff, pKey->iKey & 0xff);
+        }
+        else
+        {
+            _DirtyMemTrackPrintf(pReport, "  group 0x%08x", pKey->iKey);
+        }
+        _DirtyMemTrackPrintf(pReport, " live %lld bytes in %d allocs, peak %lld bytes in %d allocs\n",
+            (long long)Stat.iLiveBytes, Stat.iLiveCount, (long long)Stat.iPeakBytes, Stat.iPeakCount);
+    }
+}
+#endif
+
+/*** Public functions *************************************************************/
+
+/*F********************************************************************************/
+/*!
+    \Function DirtyMemGroupEnter
+
+    \Description
+        Push a memory group onto the calling thread's group stack.
+
+    \Input iGroup               - memory group
+    \Input *pMemGroupUserData   - user data associated with the group
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+void DirtyMemGroupEnter(int32_t iGroup, void *pMemGroupUserData)
+{
+    DirtyMemGroupStackT *pStack = &_DirtyMem_GroupStack;
+
+    if (pStack->iDepth >= DIRTYMEM_MAXGROUPS)
+    {
+        NetPrintf(("dirtymem: group stack overflow entering group %d\n", iGroup));
+        pStack->iOverflow += 1;
+        return;
+    }
+    pStack->aMemGroup[pStack->iDepth] = iGroup;
+    pStack->aMemGroupUserData[pStack->iDepth] = pMemGroupUserData;
+    pStack->iDepth += 1;
+}
+
+/*F********************************************************************************/
+/*!
+    \Function DirtyMemGroupLeave
+
+    \Description
+        Pop the current memory group off the calling thread's group stack. Leaves
+        matching enters that overflowed the stack pop nothing.
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+void DirtyMemGroupLeave(void)
+{
+    DirtyMemGroupStackT *pStack = &_DirtyMem_GroupStack;
+
+    if (pStack->iOverflow > 0)
+    {
+        pStack->iOverflow -= 1;
+        return;
+    }
+    if (pStack->iDepth <= 0)
+    {
+        NetPrintf(("dirtymem: group stack underflow\n"));
+        return;
+    }
+    pStack->iDepth -= 1;
+}
+
+/*F********************************************************************************/
+/*!
+    \Function DirtyMemGroupQuery
+
+    \Description
+        Get the calling thread's current memory group.
+
+    \Input *pMemGroup           - [out] current memory group (may be NULL)
+    \Input **ppMemGroupUserData - [out] current memory group user data (may be NULL)
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+void DirtyMemGroupQuery(int32_t *pMemGroup, void **ppMemGroupUserData)
+{
+    DirtyMemGroupStackT *pStack = &_DirtyMem_GroupStack;
+    int32_t iDepth = pStack->iDepth;
+
+    if (pMemGroup != NULL)
+    {
+        *pMemGroup = (iDepth > 0) ? pStack->aMemGroup[iDepth-1] : 0;
+    }
+    if (ppMemGroupUserData != NULL)
+    {
+        *ppMemGroupUserData = (iDepth > 0) ? pStack->aMemGroupUserData[iDepth-1] : NULL;
+    }
+}
+
+#if DIRTYCODE_MEMTRACK
+/*F********************************************************************************/
+/*!
+    \Function DirtyMemDebugCreate
+
+    \Description
+        Start tracking live allocations.
+
+    \Input uSampleRate  - record a backtrace for one in uSampleRate allocations (zero=never)
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+void DirtyMemDebugCreate(uint32_t uSampleRate)
+{
+    int32_t iStripe;
+
+    if (_DirtyMem_Track.bActive)
+    {
+        return;
+    }
+    memset(&_DirtyMem_Track, 0, sizeof(_DirtyMem_Track));
+    NetCritInit(&_DirtyMem_Track.Crit, "dirtymem-track");
+    for (iStripe = 0; iStripe < DIRTYMEM_TRACK_STRIPES; iStripe += 1)
+    {
+        NetCritInit(&_DirtyMem_Track.aStripes[iStripe].Crit, "dirtymem-track-stripe");
+    }
+    _DirtyMem_Track.uSampleRate = uSampleRate;
+    _DirtyMem_Track.bActive = TRUE;
+}
+
+/*F********************************************************************************/
+/*!
+    \Function DirtyMemDebugDestroy
+
+    \Description
+        Stop tracking and release all tracker memory. Must not be called while
+        other threads are allocating.
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+void DirtyMemDebugDestroy(void)
+{
+    DirtyMemTrackEntryT *pEntry;
+    int32_t iStripe, iBucket;
+
+    if (!_DirtyMem_Track.bActive)
+    {
+        return;
+    }
+    _DirtyMem_Track.bActive = FALSE;
+    for (iStripe = 0; iStripe < DIRTYMEM_TRACK_STRIPES; iStripe += 1)
+    {
+        DirtyMemTrackStripeT *pStripe = &_DirtyMem_Track.aStripes[iStripe];
+        for (iBucket = 0; iBucket < DIRTYMEM_TRACK_BUCKETS; iBucket += 1)
+        {
+            while ((pEntry = pStripe->aBuckets[iBucket]) != NULL)
+            {
+                pStripe->aBuckets[iBucket] = pEntry->pNext;
+                free(pEntry->pFrames);
+                free(pEntry);
+            }
+        }
+        while ((pEntry = pStripe->pFree) != NULL)
+        {
+            pStripe->pFree = pEntry->pNext;
+            free(pEntry);
+        }
+        NetCritKill(&pStripe->Crit);
+    }
+    NetCritKill(&_DirtyMem_Track.Crit);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function DirtyMemDebugAlloc
+
+    \Description
+        Record an allocation with the live allocation tracker. Called by the
+        DirtyMemAlloc() implementation after a successful allocation.
+
+    \Input *pMem                - allocated memory
+    \Input iSize                - size of the allocation
+    \Input iMemModule           - module memid
+    \Input iMemGroup            - memory group
+    \Input *pMemGroupUserData   - memory group user data
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+void DirtyMemDebugAlloc(void *pMem, int32_t iSize, int32_t iMemModule, int32_t iMemGroup, void *pMemGroupUserData)
+{
+    DirtyMemTrackFramesT *pFrames = NULL;
+    DirtyMemTrackStripeT *pStripe;
+    DirtyMemTrackEntryT *pEntry;
+    uint32_t uBucket;
+
+    if (!_DirtyMem_Track.bActive || (pMem == NULL))
+    {
+        return;
+    }
+
+    // capture a backtrace for sampled allocations before taking the lock
+    if ((_DirtyMem_Track.uSampleRate != 0) && ((++_DirtyMem_uTrackSample % _DirtyMem_Track.uSampleRate) == 0))
+    {
+        #if DIRTYCODE_PLATFORM == DIRTYCODE_LINUX
+        if ((pFrames = (DirtyMemTrackFramesT *)malloc(sizeof(*pFrames))) != NULL)
+        {
+            pFrames->iNumFrames = backtrace(pFrames->aFrames, DIRTYMEM_TRACK_FRAMES);
+        }
+        #endif
+    }
+
+    pStripe = _DirtyMemTrackStripe(pMem, &uBucket);
+    NetCritEnter(&pStripe->Crit);
+    if ((pEntry = pStripe->pFree) != NULL)
+    {
+        pStripe->pFree = pEntry->pNext;
+    }
+    else if ((pEntry = (DirtyMemTrackEntryT *)malloc(sizeof(*pEntry))) == NULL)
+    {
+        NetCritLeave(&pStripe->Crit);
+        free(pFrames);
+        return;
+    }
+    pEntry->pMem = pMem;
+    pEntry->iSize = iSize;
+    pEntry->iMemModule = iMemModule;
+    pEntry->iMemGroup = iMemGroup;
+    pEntry->pFrames = pFrames;
+    pEntry->pNext = pStripe->aBuckets[uBucket];
+    pStripe->aBuckets[uBucket] = pEntry;
+    _DirtyMemTrackAccount(iMemModule, iMemGroup, iSize);
+    NetCritLeave(&pStripe->Crit);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function DirtyMemDebugFree
+
+    \Description
+        Record a free with the live allocation tracker. Called by the DirtyMemFree()
+        implementation before the memory is released. Size, module and group are
+        taken from the tracked allocation; frees of untracked pointers are ignored.
+
+    \Input *pMem                - memory being freed
+    \Input iSize                - size of the allocation (unused)
+    \Input iMemModule           - module memid (unused)
+    \Input iMemGroup            - memory group (unused)
+    \Input *pMemGroupUserData   - memory group user data
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+void DirtyMemDebugFree(void *pMem, int32_t iSize, int32_t iMemModule, int32_t iMemGroup, void *pMemGroupUserData)
+{
+    DirtyMemTrackEntryT *pEntry, **ppEntry;
+    DirtyMemTrackFramesT *pFrames = NULL;
+    DirtyMemTrackStripeT *pStripe;
+    uint32_t uBucket, bFound = FALSE;
+
+    if (!_DirtyMem_Track.bActive || (pMem == NULL))
+    {
+        return;
+    }
+
+    pStripe = _DirtyMemTrackStripe(pMem, &uBucket);
+    NetCritEnter(&pStripe->Crit);
+    for (ppEntry = &pStripe->aBuckets[uBucket]; (pEntry = *ppEntry) != NULL; ppEntry = &pEntry->pNext)
+    {
+        if (pEntry->pMem == pMem)
+        {
+            *ppEntry = pEntry->pNext;
+            _DirtyMemTrackAccount(pEntry->iMemModule, pEntry->iMemGroup, -pEntry->iSize);
+            pFrames = pEntry->pFrames;
+            pEntry->pNext = pStripe->pFree;
+            pStripe->pFree = pEntry;
+            bFound = TRUE;
+            break;
+        }
+    }
+    NetCritLeave(&pStripe->Crit);
+
+    if (bFound)
+    {
+        free(pFrames);
+    }
+}
+
+/*F********************************************************************************/
+/*!
+    \Function DirtyMemDebugRelease
+
+    \Description
+        Forget every tracked allocation in a memory group whose memory was released
+        as a whole, without individual frees.
+
+    \Input iMemGroup    - memory group
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+void DirtyMemDebugRelease(int32_t iMemGroup)
+{
+    DirtyMemTrackEntryT *pEntry, **ppEntry;
+    int32_t iStripe, iBucket;
+
+    if (!_DirtyMem_Track.bActive)
+    {
+        return;
+    }
+    for (iStripe = 0; iStripe < DIRTYMEM_TRACK_STRIPES; iStripe += 1)
+    {
+        DirtyMemTrackStripeT *pStripe = &_DirtyMem_Track.aStripes[iStripe];
+        NetCritEnter(&pStripe->Crit);
+        for (iBucket = 0; iBucket < DIRTYMEM_TRACK_BUCKETS; iBucket += 1)
+        {
+            for (ppEntry = &pStripe->aBuckets[iBucket]; (pEntry = *ppEntry) != NULL; )
+            {
+                if (pEntry->iMemGroup != iMemGroup)
+                {
+                    ppEntry = &pEntry->pNext;
+                    continue;
+                }
+                *ppEntry = pEntry->pNext;
+                _DirtyMemTrackAccount(pEntry->iMemModule, pEntry->iMemGroup, -pEntry->iSize);
+                free(pEntry->pFrames);
+                pEntry->pNext = pStripe->pFree;
+                pStripe->pFree = pEntry;
+            }
+        }
+        NetCritLeave(&pStripe->Crit);
+    }
+}
+
+/*F********************************************************************************/
+/*!
+    \Function DirtyMemDebugModuleStat
+
+    \Description
+        Get live allocation statistics for a module.
+
+    \Input iMemModule   - module memid
+    \Input *pStat       - [out] statistics
+
+    \Output
+        int32_t         - zero=success, negative=module has not allocated
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+int32_t DirtyMemDebugModuleStat(int32_t iMemModule, DirtyMemDebugStatT *pStat)
+{
+    if (!_DirtyMem_Track.bActive)
+    {
+        memset(pStat, 0, sizeof(*pStat));
+        return(-1);
+    }
+    return(_DirtyMemTrackGet(_DirtyMem_Track.aModules, iMemModule, pStat));
+}
+
+/*F********************************************************************************/
+/*!
+    \Function DirtyMemDebugGroupStat
+
+    \Description
+        Get live allocation statistics for a memory group.
+
+    \Input iMemGroup    - memory group
+    \Input *pStat       - [out] statistics
+
+    \Output
+        int32_t         - zero=success, negative=group has not allocated
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+int32_t DirtyMemDebugGroupStat(int32_t iMemGroup, DirtyMemDebugStatT *pStat)
+{
+    if (!_DirtyMem_Track.bActive)
+    {
+        memset(pStat, 0, sizeof(*pStat));
+        return(-1);
+    }
+    return(_DirtyMemTrackGet(_DirtyMem_Track.aGroups, iMemGroup, pStat));
+}
+
+/*F********************************************************************************/
+/*!
+    \Function DirtyMemDebugReport
+
+    \Description
+        Report live allocations per module and per group, followed by up to
+        DIRTYMEM_TRACK_MAXSAMPLES sampled live allocations with their backtraces.
+
+    \Input *pBuffer     - output buffer, or NULL to send the report to debug output
+    \Input iBufSize     - size of output buffer
+
+    \Output
+        int32_t         - length of the full report; the buffer holds only the lines that fit
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+int32_t DirtyMemDebugReport(char *pBuffer, int32_t iBufSize)
+{
+    DirtyMemTrackReportT Report;
+    int32_t iStripe, iBucket, iFrame, iSamples = 0;
+
+    Report.pBuffer = pBuffer;
+    Report.iBufSize = iBufSize;
+    Report.iLength = 0;
+    if ((pBuffer != NULL) && (iBufSize > 0))
+    {
+        pBuffer[0] = '\0';
+    }
+    if (!_DirtyMem_Track.bActive)
+    {
+        return(0);
+    }
+
+    _DirtyMemTrackPrintf(&Report, "dirtymem: live allocation report\n");
+    _DirtyMemTrackReportKeys(&Report, _DirtyMem_Track.aModules, TRUE);
+    _DirtyMemTrackReportKeys(&Report, _DirtyMem_Track.aGroups, FALSE);
+
+    for (iStripe = 0; (iStripe < DIRTYMEM_TRACK_STRIPES) && (iSamples < DIRTYMEM_TRACK_MAXSAMPLES); iStripe += 1)
+    {
+        DirtyMemTrackStripeT *pStripe = &_DirtyMem_Track.aStripes[iStripe];
+        NetCritEnter(&pStripe->Crit);
+        for (iBucket = 0; (iBucket < DIRTYMEM_TRACK_BUCKETS) && (iSamples < DIRTYMEM_TRACK_MAXSAMPLES); iBucket += 1)
+        {
+            DirtyMemTrackEntryT *pEntry;
+            for (pEntry = pStripe->aBuckets[iBucket]; (pEntry != NULL) && (iSamples < DIRTYMEM_TRACK_MAXSAMPLES); pEntry = pEntry->pNext)
+            {
+                if (pEntry->pFrames == NULL)
+                {
+                    continue;
+                }
+                _DirtyMemTrackPrintf(&Report, "  sample %p %d bytes module '%c%c%c%c' group 0x%08x:", pEntry->pMem, pEntry->iSize,
+                    (pEntry->iMemModule >> 24) & 0xff, (pEntry->iMemModule >> 16) & 0xff, (pEntry->iMemModule >> 8) & 0xff, pEntry->iMemModule & 0xff, pEntry->iMemGroup);
+                for (iFrame = 0; iFrame < pEntry->pFrames->iNumFrames; iFrame += 1)
+                {
+                    _DirtyMemTrackPrintf(&Report, " %p", pEntry->pFrames->aFrames[iFrame]);
+                }
+                _DirtyMemTrackPrintf(&Report, "\n");
+                iSamples += 1;
+            }
+        }
+        NetCritLeave(&pStripe->Crit);
+    }
+    return(Report.iLength);
+}
+#endif // DIRTYCODE_MEMTRACK
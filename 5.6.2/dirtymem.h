@@ -147,15 +147,30 @@
 #define PLAYERSYNCSERVICE_MEMID ('plss')  // used by PlayerSyncSDK package
 
 
+//! live allocation tracking behind DirtyMemDebugAlloc()/DirtyMemDebugFree(); defaults to debug builds only
+#ifndef DIRTYCODE_MEMTRACK
+ #define DIRTYCODE_MEMTRACK (DIRTYCODE_DEBUG)
+#endif
+
 /*** Macros ***********************************************************************/
 
-#if !DIRTYCODE_DEBUG
+#if !DIRTYCODE_MEMTRACK
  #define DirtyMemDebugAlloc(_pMem, _iSize, _iMemModule, _iMemGroup, _pMemGroupUserData) {;}
  #define DirtyMemDebugFree(_pMem, _iSize, _iMemModule, _iMemGroup, _pMemGroupUserData) {;}
+ #define DirtyMemDebugRelease(_iMemGroup) {;}
 #endif
 
 /*** Type Definitions *************************************************************/
 
+//! live allocation statistics for one module or memory group
+typedef struct DirtyMemDebugStatT
+{
+    int64_t iLiveBytes;     //!< bytes currently allocated
+    int64_t iPeakBytes;     //!< high-water mark of iLiveBytes
+    int32_t iLiveCount;     //!< number of live allocations
+    int32_t iPeakCount;     //!< high-water mark of iLiveCount
+} DirtyMemDebugStatT;
+
 /*** Variables ********************************************************************/
 
 /*** Functions ********************************************************************/
@@ -173,16 +188,35 @@ void DirtyMemGroupLeave(void);
 //! get current memory group
 void DirtyMemGroupQuery(int32_t *pMemGroup, void **ppMemGroupUserData);
 
-#if DIRTYCODE_DEBUG
-//! display memory allocation info to debug output (debug only)
+#if DIRTYCODE_MEMTRACK
+//! record an allocation with the live allocation tracker
 void DirtyMemDebugAlloc(void *pMem, int32_t iSize, int32_t iMemModule, int32_t iMemGroup, void *pMemGroupUserData);
 
-//! display memory free info to debug output (debug only)
+//! record a free with the live allocation tracker
 void DirtyMemDebugFree(void *pMem, int32_t iSize, int32_t iMemModule, int32_t iMemGroup, void *pMemGroupUserData);
+
+//! forget every tracked allocation in a memory group released as a whole
+void DirtyMemDebugRelease(int32_t iMemGroup);
+
+//! start tracking live allocations, capturing a backtrace for one in uSampleRate allocations (zero=none)
+void DirtyMemDebugCreate(uint32_t uSampleRate);
+
+//! stop tracking and release tracker memory
+void DirtyMemDebugDestroy(void);
+
+//! get live allocation statistics for a module
+int32_t DirtyMemDebugModuleStat(int32_t iMemModule, DirtyMemDebugStatT *pStat);
+
+//! get live allocation statistics for a memory group
+int32_t DirtyMemDebugGroupStat(int32_t iMemGroup, DirtyMemDebugStatT *pStat);
+
+//! format a live allocation report into a buffer, or to debug output if pBuffer is NULL
+int32_t DirtyMemDebugReport(char *pBuffer, int32_t iBufSize);
 #endif
 
 /*
  Memory allocation routines - not implemented in the lib; these must be supplied by the user
+ (dirtymemarena.c provides a reference implementation that may be linked instead)
 */
 
 //! allocate memory
@@ -0,0 +1,1184 @@
+/*H********************************************************************************/
+/*!
+    \File dirtymemarena.c
+
+    \Description
+        Reference DirtyMemAlloc()/DirtyMemFree() backend built on per-memgroup
+        arenas.
+
+    \Notes
+        Each arena carves fixed size-class blocks out of large chunks and keeps a
+        free list per class; blocks are never returned to the system until the
+        whole group is released. Requests larger than the biggest class go
+        straight to the system allocator and are linked into the arena so that
+        DirtyMemArenaRelease() can reclaim them too.
+
+        Every block is preceded by a 16-byte header recording the owning arena,
+        size class, requested size and module, so DirtyMemFree() does not rely on
+        the caller passing back the same group it allocated with.
+
+        With DIRTYMEM_ARENA_FLAG_THREADCACHE each thread keeps magazines of small
+        blocks for the arena it last allocated from, and only takes the arena
+        lock to refill or drain half a magazine at a time. Frees of blocks that
+        belong to another arena are batched and handed back to that arena in one
+        lock acquisition. Statistic updates are batched the same way, so group
+        and module statistics lag by what threads hold in their caches until
+        DirtyMemArenaThreadFlush() is called (or the thread exits, on Linux).
+
+    \Version 10/18/2026 (agent) First Version
+*/
+/********************************************************************************H*/
+
+/*** Include files ****************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dirtysock.h"
+#include "dirtymem.h"
+#include "dirtymemarena.h"
+
+#if DIRTYCODE_PLATFORM == DIRTYCODE_LINUX
+#include <pthread.h>
+#include <sys/mman.h>
+#endif
+
+/*** Defines **********************************************************************/
+
+#define DIRTYMEM_ARENA_NUMCLASSES       (40)            //!< 16..128 in steps of 16, then four classes per power of two
+#define DIRTYMEM_ARENA_MAXCLASSSIZE     (32768)         //!< size of the largest class
+#define DIRTYMEM_ARENA_LARGE            (0xffff)        //!< uClass value for blocks outside the class table
+#define DIRTYMEM_ARENA_NOMODULE         (0xffff)        //!< uModule value when the module table is full
+#define DIRTYMEM_ARENA_CHUNKSIZE        (256*1024)      //!< default chunk size
+#define DIRTYMEM_ARENA_HUGECHUNKSIZE    (2*1024*1024)   //!< chunk size when backed by huge pages
+#define DIRTYMEM_ARENA_CHUNKHEAD        (32)            //!< chunk header size, keeps blocks 16-byte aligned
+#define DIRTYMEM_ARENA_CACHECLASSES     (24)            //!< classes cached per thread (up to 2KB)
+#define DIRTYMEM_ARENA_MAGSIZE          (32)            //!< blocks per thread magazine
+#define DIRTYMEM_ARENA_CACHEMODULES     (8)             //!< modules with pending statistics per thread
+
+/*** Type Definitions *************************************************************/
+
+//! header in front of every block handed out
+typedef struct DirtyMemArenaHeadT
+{
+    uint32_t uSize;             //!< requested size
+    int32_t iMemModule;         //!< module that allocated the block
+    uint16_t uArena;            //!< index of the owning arena
+    uint16_t uClass;            //!< size class, or DIRTYMEM_ARENA_LARGE
+    uint16_t uModule;           //!< slot in the arena module table
+    uint16_t uPad;
+} DirtyMemArenaHeadT;
+
+//! large block prefix, linked so the arena can release it
+typedef struct DirtyMemArenaLargeT
+{
+    struct DirtyMemArenaLargeT *pNext;
+    struct DirtyMemArenaLargeT *pPrev;
+    #if !DIRTYCODE_64BITPTR
+    uint32_t aPad[2];           //!< keep the block 16-byte aligned
+    #endif
+    DirtyMemArenaHeadT Head;
+} DirtyMemArenaLargeT;
+
+//! chunk of memory blocks are carved from
+typedef struct DirtyMemArenaChunkT
+{
+    struct DirtyMemArenaChunkT *pNext;
+    uint32_t uSize;             //!< total chunk size, including this header
+    uint32_t uUsed;             //!< bump offset of the next unused byte
+    uint32_t bMapped;           //!< chunk came from mmap rather than malloc
+} DirtyMemArenaChunkT;
+
+//! one arena per active memory group
+typedef struct DirtyMemArenaT
+{
+    NetCritT Crit;
+    int32_t iMemGroup;
+    uint32_t bActive;           //!< set/cleared under the module lock; thread caches read it atomically without it
+    uint32_t uGeneration;       //!< changes whenever the arena memory is released; read atomically by thread caches
+    void *aFree[DIRTYMEM_ARENA_NUMCLASSES];
+    DirtyMemArenaChunkT *pChunks;
+    DirtyMemArenaLargeT *pLarge;
+    DirtyMemArenaStatT Stat;
+    int32_t aModuleIds[DIRTYMEM_ARENA_MAXMODULES];
+    DirtyMemArenaStatT aModuleStat[DIRTYMEM_ARENA_MAXMODULES];
+} DirtyMemArenaT;
+
+//! statistics a thread cache has not applied to its arena yet
+typedef struct DirtyMemArenaCacheModT
+{
+    int32_t iMemModule;
+    uint32_t uModule;           //!< slot in the arena module table
+    int64_t iLiveBytes;
+    int32_t iLiveCount;
+    uint32_t uTotalAllocs;
+} DirtyMemArenaCacheModT;
+
+//! per-thread block cache
+typedef struct DirtyMemArenaCacheT
+{
+    DirtyMemArenaT *pArena;     //!< arena the magazines belong to, NULL if none
+    uint32_t uGeneration;       //!< arena generation the magazines were filled from
+    int32_t iNumModules;
+    DirtyMemArenaCacheModT aModules[DIRTYMEM_ARENA_CACHEMODULES];
+    DirtyMemArenaT *pRemote;    //!< arena of the batched foreign frees, NULL if none
+    uint32_t uRemoteGeneration;
+    int32_t iNumRemote;
+    DirtyMemArenaHeadT *aRemote[DIRTYMEM_ARENA_MAGSIZE];
+    uint8_t aCount[DIRTYMEM_ARENA_CACHECLASSES];
+    DirtyMemArenaHeadT *aMagazine[DIRTYMEM_ARENA_CACHECLASSES][DIRTYMEM_ARENA_MAGSIZE];
+} DirtyMemArenaCacheT;
+
+//! module state
+typedef struct DirtyMemArenaStateT
+{
+    NetCritT Crit;              //!< guards arena creation and lookup
+    uint32_t uFlags;            //!< DIRTYMEM_ARENA_FLAG_*
+    uint32_t bCreated;
+    #if DIRTYCODE_PLATFORM == DIRTYCODE_LINUX
+    pthread_key_t ThreadKey;    //!< used to flush thread caches at thread exit
+    #endif
+    DirtyMemArenaT aArenas[DIRTYMEM_ARENA_MAXGROUPS];
+} DirtyMemArenaStateT;
+
+/*** Variables ********************************************************************/
+
+static DirtyMemArenaStateT _DirtyMemArena;
+
+//! arena generation counter; never reset, so stale thread caches are always detected
+static uint32_t _DirtyMemArena_uGeneration = 0;
+
+//! calling thread's block cache
+static DIRTYCODE_THREADLOCAL DirtyMemArenaCacheT _DirtyMemArena_Cache;
+
+/*** Private Functions ************************************************************/
+
+/*F********************************************************************************/
+/*!
+    \Function _DirtyMemArenaClassSize
+
+    \Description
+        Get the block size of a size class.
+
+    \Input uClass   - size class
+
+    \Output
+        uint32_t    - block size in bytes
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static uint32_t _DirtyMemArenaClassSize(uint32_t uClass)
+{
+    uint32_t uGroup;
+    if (uClass < 8)
+    {
+        return((uClass + 1) * 16);
+    }
+    uGroup = (uClass - 8) / 4;
+    return((128u << uGroup) + (((uClass - 8) % 4) + 1) * (32u << uGroup));
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _DirtyMemArenaSizeClass
+
+    \Description
+        Get the smallest size class that fits the given size.
+
+    \Input uSize    - requested size (at most DIRTYMEM_ARENA_MAXCLASSSIZE)
+
+    \Output
+        uint32_t    - size class
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static uint32_t _DirtyMemArenaSizeClass(uint32_t uSize)
+{
+    uint32_t uGroup, uBits;
+    if (uSize <= 128)
+    {
+        return((uSize > 0) ? (uSize - 1) / 16 : 0);
+    }
+    // find the power of two range (128<<uGroup, 256<<uGroup] the size falls in
+    for (uBits = 0, uGroup = (uSize - 1) >> 8; uGroup != 0; uGroup >>= 1)
+    {
+        uBits += 1;
+    }
+    return(8 + uBits * 4 + (((uSize - 1) - (128u << uBits)) >> (5 + uBits)));
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _DirtyMemArenaModule
+
+    \Description
+        Find or add a module in the arena module table.
+
+    \Input *pArena      - arena
+    \Input iMemModule   - module memid
+
+    \Output
+        uint32_t        - module slot, or DIRTYMEM_ARENA_NOMODULE if the table is full
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static uint32_t _DirtyMemArenaModule(DirtyMemArenaT *pArena, int32_t iMemModule)
+{
+    uint32_t uSlot, uProbe;
+    for (uProbe = 0, uSlot = (((uint32_t)iMemModule * 2654435761u) >> 16) % DIRTYMEM_ARENA_MAXMODULES; uProbe < DIRTYMEM_ARENA_MAXMODULES; uProbe += 1, uSlot = (uSlot + 1) % DIRTYMEM_ARENA_MAXMODULES)
+    {
+        if (pArena->aModuleIds[uSlot] == iMemModule)
+        {
+            return(uSlot);
+        }
+        if (pArena->aModuleIds[uSlot] == 0)
+        {
+            pArena->aModuleIds[uSlot] = iMemModule;
+            return(uSlot);
+        }
+    }
+    return(DIRTYMEM_ARENA_NOMODULE);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _DirtyMemArenaStatUpdate
+
+    \Description
+        Apply allocation and free deltas to a set of statistics.
+
+    \Input *pStat       - statistics to update
+    \Input iBytes       - change in live bytes
+    \Input iCount       - change in live allocation count
+    \Input uAllocs      - number of new allocations
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static void _DirtyMemArenaStatUpdate(DirtyMemArenaStatT *pStat, int64_t iBytes, int32_t iCount, uint32_t uAllocs)
+{
+    pStat->iLiveBytes += iBytes;
+    pStat->iLiveCount += iCount;
+    pStat->uTotalAllocs += uAllocs;
+    if (pStat->iLiveBytes > pStat->iPeakBytes)
+    {
+        pStat->iPeakBytes = pStat->iLiveBytes;
+    }
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _DirtyMemArenaChunkAlloc
+
+    \Description
+        Reserve a new chunk from the system.
+
+    \Output
+        DirtyMemArenaChunkT *   - new chunk, or NULL if out of memory
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static DirtyMemArenaChunkT *_DirtyMemArenaChunkAlloc(void)
+{
+    DirtyMemArenaChunkT *pChunk = NULL;
+    uint32_t uSize = DIRTYMEM_ARENA_CHUNKSIZE, bMapped = FALSE;
+
+    #if DIRTYCODE_PLATFORM == DIRTYCODE_LINUX
+    if (_DirtyMemArena.uFlags & DIRTYMEM_ARENA_FLAG_HUGEPAGES)
+    {
+        void *pMem = MAP_FAILED;
+        uSize = DIRTYMEM_ARENA_HUGECHUNKSIZE;
+        #if defined(MAP_HUGETLB)
+        // prefer reserved huge pages, then fall back to transparent huge pages
+        pMem = mmap(NULL, uSize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB, -1, 0);
+        #endif
+        if (pMem == MAP_FAILED)
+        {
+            pMem = mmap(NULL, uSize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+            #if defined(MADV_HUGEPAGE)
+            if (pMem != MAP_FAILED)
+            {
+                madvise(pMem, uSize, MADV_HUGEPAGE);
+            }
+            #endif
+        }
+        if (pMem != MAP_FAILED)
+        {
+            pChunk = (DirtyMemArenaChunkT *)pMem;
+            bMapped = TRUE;
+        }
+        else
+        {
+            uSize = DIRTYMEM_ARENA_CHUNKSIZE;
+        }
+    }
+    #endif
+
+    if ((pChunk == NULL) && ((pChunk = (DirtyMemArenaChunkT *)malloc(uSize)) == NULL))
+    {
+        return(NULL);
+    }
+    pChunk->pNext = NULL;
+    pChunk->uSize = uSize;
+    pChunk->uUsed = DIRTYMEM_ARENA_CHUNKHEAD;
+    pChunk->bMapped = bMapped;
+    return(pChunk);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _DirtyMemArenaChunkFree
+
+    \Description
+        Return a chunk to the system.
+
+    \Input *pChunk  - chunk to free
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static void _DirtyMemArenaChunkFree(DirtyMemArenaChunkT *pChunk)
+{
+    #if DIRTYCODE_PLATFORM == DIRTYCODE_LINUX
+    if (pChunk->bMapped)
+    {
+        munmap(pChunk, pChunk->uSize);
+        return;
+    }
+    #endif
+    free(pChunk);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _DirtyMemArenaGet
+
+    \Description
+        Find the arena for a memory group, optionally creating it.
+
+    \Input iMemGroup    - memory group
+    \Input bCreate      - create the arena if the group does not have one
+
+    \Output
+        DirtyMemArenaT *    - arena, or NULL if not found/no free slot
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static DirtyMemArenaT *_DirtyMemArenaGet(int32_t iMemGroup, uint32_t bCreate)
+{
+    DirtyMemArenaT *pArena, *pFree = NULL;
+    int32_t iArena;
+
+    NetCritEnter(&_DirtyMemArena.Crit);
+    for (iArena = 0; iArena < DIRTYMEM_ARENA_MAXGROUPS; iArena += 1)
+    {
+        pArena = &_DirtyMemArena.aArenas[iArena];
+        if (pArena->bActive && (pArena->iMemGroup == iMemGroup))
+        {
+            NetCritLeave(&_DirtyMemArena.Crit);
+            return(pArena);
+        }
+        if (!pArena->bActive && (pFree == NULL))
+        {
+            pFree = pArena;
+        }
+    }
+    if (bCreate && (pFree != NULL))
+    {
+        __atomic_store_n(&pFree->iMemGroup, iMemGroup, __ATOMIC_RELAXED);
+        __atomic_store_n(&pFree->bActive, TRUE, __ATOMIC_RELEASE);
+    }
+    else
+    {
+        pFree = NULL;
+    }
+    NetCritLeave(&_DirtyMemArena.Crit);
+    return(pFree);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _DirtyMemArenaReset
+
+    \Description
+        Return all of an arena's memory to the system and clear its statistics.
+        The caller must hold the arena critical section.
+
+    \Input *pArena  - arena to reset
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static void _DirtyMemArenaReset(DirtyMemArenaT *pArena)
+{
+    DirtyMemArenaChunkT *pChunk;
+    DirtyMemArenaLargeT *pLarge;
+
+    while ((pChunk = pArena->pChunks) != NULL)
+    {
+        pArena->pChunks = pChunk->pNext;
+        _DirtyMemArenaChunkFree(pChunk);
+    }
+    while ((pLarge = pArena->pLarge) != NULL)
+    {
+        pArena->pLarge = pLarge->pNext;
+        free(pLarge);
+    }
+    memset(pArena->aFree, 0, sizeof(pArena->aFree));
+    memset(&pArena->Stat, 0, sizeof(pArena->Stat));
+    memset(pArena->aModuleIds, 0, sizeof(pArena->aModuleIds));
+    memset(pArena->aModuleStat, 0, sizeof(pArena->aModuleStat));
+    __atomic_store_n(&pArena->uGeneration, __atomic_add_fetch(&_DirtyMemArena_uGeneration, 1, __ATOMIC_RELAXED), __ATOMIC_RELEASE);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _DirtyMemArenaBlockAlloc
+
+    \Description
+        Take a block of the given class from the arena free list, or carve a new
+        one. The caller must hold the arena critical section.
+
+    \Input *pArena  - arena
+    \Input uClass   - size class
+
+    \Output
+        DirtyMemArenaHeadT *    - block, or NULL if out of memory
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static DirtyMemArenaHeadT *_DirtyMemArenaBlockAlloc(DirtyMemArenaT *pArena, uint32_t uClass)
+{
+    DirtyMemArenaChunkT *pChunk = pArena->pChunks;
+    DirtyMemArenaHeadT *pHead;
+    uint32_t uBlock;
+
+    if ((pHead = (DirtyMemArenaHeadT *)pArena->aFree[uClass]) != NULL)
+    {
+        // pop the free list; the link is stored in the block body
+        pArena->aFree[uClass] = *(void **)(pHead + 1);
+        return(pHead);
+    }
+    uBlock = sizeof(*pHead) + _DirtyMemArenaClassSize(uClass);
+    if ((pChunk == NULL) || ((pChunk->uSize - pChunk->uUsed) < uBlock))
+    {
+        if ((pChunk = _DirtyMemArenaChunkAlloc()) == NULL)
+        {
+            return(NULL);
+        }
+        pChunk->pNext = pArena->pChunks;
+        pArena->pChunks = pChunk;
+        pArena->Stat.iReservedBytes += pChunk->uSize;
+    }
+    pHead = (DirtyMemArenaHeadT *)((uint8_t *)pChunk + pChunk->uUsed);
+    pHead->uClass = (uint16_t)uClass;
+    pChunk->uUsed += uBlock;
+    return(pHead);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _DirtyMemArenaBlockFree
+
+    \Description
+        Put a block back on its arena free list. The caller must hold the arena
+        critical section.
+
+    \Input *pArena  - arena
+    \Input *pHead   - block to free
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static void _DirtyMemArenaBlockFree(DirtyMemArenaT *pArena, DirtyMemArenaHeadT *pHead)
+{
+    *(void **)(pHead + 1) = pArena->aFree[pHead->uClass];
+    pArena->aFree[pHead->uClass] = pHead;
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _DirtyMemArenaCacheStats
+
+    \Description
+        Apply a thread cache's pending statistics to its arena. The caller must
+        hold the arena critical section.
+
+    \Input *pCache  - thread cache
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static void _DirtyMemArenaCacheStats(DirtyMemArenaCacheT *pCache)
+{
+    DirtyMemArenaT *pArena = pCache->pArena;
+    int32_t iModule;
+
+    for (iModule = 0; iModule < pCache->iNumModules; iModule += 1)
+    {
+        DirtyMemArenaCacheModT *pMod = &pCache->aModules[iModule];
+        if (pCache->uGeneration == pArena->uGeneration)
+        {
+            _DirtyMemArenaStatUpdate(&pArena->Stat, pMod->iLiveBytes, pMod->iLiveCount, pMod->uTotalAllocs);
+            if (pMod->uModule != DIRTYMEM_ARENA_NOMODULE)
+            {
+                _DirtyMemArenaStatUpdate(&pArena->aModuleStat[pMod->uModule], pMod->iLiveBytes, pMod->iLiveCount, pMod->uTotalAllocs);
+            }
+        }
+        pMod->iLiveBytes = 0;
+        pMod->iLiveCount = 0;
+        pMod->uTotalAllocs = 0;
+    }
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _DirtyMemArenaCacheModule
+
+    \Description
+        Get the pending statistics entry for a module, registering the module with
+        the arena if the cache has not seen it yet.
+
+    \Input *pCache      - thread cache
+    \Input iMemModule   - module memid
+
+    \Output
+        DirtyMemArenaCacheModT * - pending statistics entry
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static DirtyMemArenaCacheModT *_DirtyMemArenaCacheModule(DirtyMemArenaCacheT *pCache, int32_t iMemModule)
+{
+    DirtyMemArenaCacheModT *pMod;
+    int32_t iModule;
+
+    for (iModule = 0; iModule < pCache->iNumModules; iModule += 1)
+    {
+        if (pCache->aModules[iModule].iMemModule == iMemModule)
+        {
+            return(&pCache->aModules[iModule]);
+        }
+    }
+
+    NetCritEnter(&pCache->pArena->Crit);
+    if (pCache->iNumModules == DIRTYMEM_ARENA_CACHEMODULES)
+    {
+        _DirtyMemArenaCacheStats(pCache);
+        pCache->iNumModules = 0;
+    }
+    pMod = &pCache->aModules[pCache->iNumModules++];
+    memset(pMod, 0, sizeof(*pMod));
+    pMod->iMemModule = iMemModule;
+    pMod->uModule = _DirtyMemArenaModule(pCache->pArena, iMemModule);
+    NetCritLeave(&pCache->pArena->Crit);
+    return(pMod);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _DirtyMemArenaCacheRemote
+
+    \Description
+        Hand the batched frees of foreign blocks back to their arena.
+
+    \Input *pCache  - thread cache
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static void _DirtyMemArenaCacheRemote(DirtyMemArenaCacheT *pCache)
+{
+    DirtyMemArenaT *pArena = pCache->pRemote;
+    int32_t iBlock;
+
+    if (pArena == NULL)
+    {
+        return;
+    }
+    NetCritEnter(&pArena->Crit);
+    // if the group was released in the meantime these blocks no longer exist
+    if (pCache->uRemoteGeneration == pArena->uGeneration)
+    {
+        for (iBlock = 0; iBlock < pCache->iNumRemote; iBlock += 1)
+        {
+            DirtyMemArenaHeadT *pHead = pCache->aRemote[iBlock];
+            _DirtyMemArenaStatUpdate(&pArena->Stat, -(int64_t)pHead->uSize, -1, 0);
+            if (pHead->uModule != DIRTYMEM_ARENA_NOMODULE)
+            {
+                _DirtyMemArenaStatUpdate(&pArena->aModuleStat[pHead->uModule], -(int64_t)pHead->uSize, -1, 0);
+            }
+            _DirtyMemArenaBlockFree(pArena, pHead);
+        }
+    }
+    NetCritLeave(&pArena->Crit);
+    pCache->pRemote = NULL;
+    pCache->iNumRemote = 0;
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _DirtyMemArenaCacheFlush
+
+    \Description
+        Return everything a thread cache holds to the owning arenas.
+
+    \Input *pCache  - thread cache
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static void _DirtyMemArenaCacheFlush(DirtyMemArenaCacheT *pCache)
+{
+    DirtyMemArenaT *pArena = pCache->pArena;
+    int32_t iClass;
+
+    _DirtyMemArenaCacheRemote(pCache);
+    if (pArena == NULL)
+    {
+        return;
+    }
+    NetCritEnter(&pArena->Crit);
+    _DirtyMemArenaCacheStats(pCache);
+    for (iClass = 0; iClass < DIRTYMEM_ARENA_CACHECLASSES; iClass += 1)
+    {
+        while ((pCache->aCount[iClass] > 0) && (pCache->uGeneration == pArena->uGeneration))
+        {
+            _DirtyMemArenaBlockFree(pArena, pCache->aMagazine[iClass][--pCache->aCount[iClass]]);
+        }
+        pCache->aCount[iClass] = 0;
+    }
+    NetCritLeave(&pArena->Crit);
+    pCache->pArena = NULL;
+    pCache->iNumModules = 0;
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _DirtyMemArenaThreadExit
+
+    \Description
+        Thread exit hook that flushes the exiting thread's cache.
+
+    \Input *pValue  - thread cache
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+#if DIRTYCODE_PLATFORM == DIRTYCODE_LINUX
+static void _DirtyMemArenaThreadExit(void *pValue)
+{
+    _DirtyMemArenaCacheFlush((DirtyMemArenaCacheT *)pValue);
+}
+#endif
+
+/*F********************************************************************************/
+/*!
+    \Function _DirtyMemArenaCacheAlloc
+
+    \Description
+        Allocate a small block through the calling thread's cache.
+
+    \Input uSize        - requested size (at most the largest cached class)
+    \Input iMemModule   - module memid
+    \Input iMemGroup    - memory group
+
+    \Output
+        DirtyMemArenaHeadT * - block, or NULL on failure
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static DirtyMemArenaHeadT *_DirtyMemArenaCacheAlloc(uint32_t uSize, int32_t iMemModule, int32_t iMemGroup)
+{
+    DirtyMemArenaCacheT *pCache = &_DirtyMemArena_Cache;
+    DirtyMemArenaT *pArena = pCache->pArena;
+    DirtyMemArenaCacheModT *pMod;
+    DirtyMemArenaHeadT *pHead;
+    uint32_t uClass = _DirtyMemArenaSizeClass(uSize);
+
+    // switch arenas if this is a different group or ours was released; read without the locks that guard the fields
+    if ((pArena == NULL) || (__atomic_load_n(&pArena->iMemGroup, __ATOMIC_RELAXED) != iMemGroup) || !__atomic_load_n(&pArena->bActive, __ATOMIC_ACQUIRE) ||
+        (pCache->uGeneration != __atomic_load_n(&pArena->uGeneration, __ATOMIC_ACQUIRE)))
+    {
+        _DirtyMemArenaCacheFlush(pCache);
+        if ((pArena = _DirtyMemArenaGet(iMemGroup, TRUE)) == NULL)
+        {
+            NetPrintf(("dirtymemarena: no arena available for group %d\n", iMemGroup));
+            return(NULL);
+        }
+        pCache->pArena = pArena;
+        pCache->uGeneration = __atomic_load_n(&pArena->uGeneration, __ATOMIC_ACQUIRE);
+        #if DIRTYCODE_PLATFORM == DIRTYCODE_LINUX
+        pthread_setspecific(_DirtyMemArena.ThreadKey, pCache);
+        #endif
+    }
+    pMod = _DirtyMemArenaCacheModule(pCache, iMemModule);
+
+    // refill half a magazine when empty
+    if (pCache->aCount[uClass] == 0)
+    {
+        NetCritEnter(&pArena->Crit);
+        _DirtyMemArenaCacheStats(pCache);
+        while ((pCache->aCount[uClass] < (DIRTYMEM_ARENA_MAGSIZE/2)) && ((pHead = _DirtyMemArenaBlockAlloc(pArena, uClass)) != NULL))
+        {
+            pCache->aMagazine[uClass][pCache->aCount[uClass]++] = pHead;
+        }
+        NetCritLeave(&pArena->Crit);
+        if (pCache->aCount[uClass] == 0)
+        {
+            return(NULL);
+        }
+    }
+    pHead = pCache->aMagazine[uClass][--pCache->aCount[uClass]];
+
+    pHead->uSize = uSize;
+    pHead->iMemModule = iMemModule;
+    pHead->uArena = (uint16_t)(pArena - _DirtyMemArena.aArenas);
+    pHead->uClass = (uint16_t)uClass;
+    pHead->uModule = (uint16_t)pMod->uModule;
+    pMod->iLiveBytes += uSize;
+    pMod->iLiveCount += 1;
+    pMod->uTotalAllocs += 1;
+    return(pHead);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _DirtyMemArenaCacheFree
+
+    \Description
+        Free a small block through the calling thread's cache.
+
+    \Input *pArena  - arena owning the block
+    \Input *pHead   - block to free
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static void _DirtyMemArenaCacheFree(DirtyMemArenaT *pArena, DirtyMemArenaHeadT *pHead)
+{
+    DirtyMemArenaCacheT *pCache = &_DirtyMemArena_Cache;
+    DirtyMemArenaCacheModT *pMod;
+    uint32_t uClass = pHead->uClass, uGeneration;
+    int32_t iBlock;
+
+    // blocks from another arena are batched and returned to their owner together
+    uGeneration = __atomic_load_n(&pArena->uGeneration, __ATOMIC_ACQUIRE);
+    if ((pCache->pArena != pArena) || (pCache->uGeneration != uGeneration))
+    {
+        if ((pCache->pRemote != pArena) || (pCache->uRemoteGeneration != uGeneration) || (pCache->iNumRemote == DIRTYMEM_ARENA_MAGSIZE))
+        {
+            _DirtyMemArenaCacheRemote(pCache);
+            pCache->pRemote = pArena;
+            pCache->uRemoteGeneration = uGeneration;
+        }
+        pCache->aRemote[pCache->iNumRemote++] = pHead;
+        return;
+    }
+
+    pMod = _DirtyMemArenaCacheModule(pCache, pHead->iMemModule);
+    if (pCache->aCount[uClass] == DIRTYMEM_ARENA_MAGSIZE)
+    {
+        // drain half the magazine back to the arena
+        NetCritEnter(&pArena->Crit);
+        _DirtyMemArenaCacheStats(pCache);
+        for (iBlock = 0; iBlock < (DIRTYMEM_ARENA_MAGSIZE/2); iBlock += 1)
+        {
+            _DirtyMemArenaBlockFree(pArena, pCache->aMagazine[uClass][--pCache->aCount[uClass]]);
+        }
+        NetCritLeave(&pArena->Crit);
+    }
+    pCache->aMagazine[uClass][pCache->aCount[uClass]++] = pHead;
+    pMod->iLiveBytes -= pHead->uSize;
+    pMod->iLiveCount -= 1;
+}
+
+/*F********************************************************************************/
+/*!
+    \Function _DirtyMemArenaAlloc
+
+    \Description
+        Allocate memory from the arena for the given memory group.
+
+    \Input iSize                - size of the allocation
+    \Input iMemModule           - module memid
+    \Input iMemGroup            - memory group
+
+    \Output
+        void *                  - 16-byte aligned memory, or NULL on failure
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static void *_DirtyMemArenaAlloc(int32_t iSize, int32_t iMemModule, int32_t iMemGroup)
+{
+    DirtyMemArenaHeadT *pHead;
+    DirtyMemArenaT *pArena;
+    uint32_t uModule;
+
+    if (iSize < 0)
+    {
+        return(NULL);
+    }
+    if ((_DirtyMemArena.uFlags & DIRTYMEM_ARENA_FLAG_THREADCACHE) && (iSize <= (int32_t)_DirtyMemArenaClassSize(DIRTYMEM_ARENA_CACHECLASSES-1)))
+    {
+        pHead = _DirtyMemArenaCacheAlloc((uint32_t)iSize, iMemModule, iMemGroup);
+        return((pHead != NULL) ? pHead + 1 : NULL);
+    }
+    if ((pArena = _DirtyMemArenaGet(iMemGroup, TRUE)) == NULL)
+    {
+        NetPrintf(("dirtymemarena: no arena available for group %d\n", iMemGroup));
+        return(NULL);
+    }
+
+    NetCritEnter(&pArena->Crit);
+    if (iSize <= DIRTYMEM_ARENA_MAXCLASSSIZE)
+    {
+        pHead = _DirtyMemArenaBlockAlloc(pArena, _DirtyMemArenaSizeClass((uint32_t)iSize));
+    }
+    else
+    {
+        DirtyMemArenaLargeT *pLarge;
+        if ((pLarge = (DirtyMemArenaLargeT *)malloc(sizeof(*pLarge) + iSize)) != NULL)
+        {
+            pLarge->pPrev = NULL;
+            if ((pLarge->pNext = pArena->pLarge) != NULL)
+            {
+                pArena->pLarge->pPrev = pLarge;
+            }
+            pArena->pLarge = pLarge;
+            pArena->Stat.iReservedBytes += sizeof(*pLarge) + iSize;
+            pHead = &pLarge->Head;
+            pHead->uClass = DIRTYMEM_ARENA_LARGE;
+        }
+        else
+        {
+            pHead = NULL;
+        }
+    }
+    if (pHead == NULL)
+    {
+        NetCritLeave(&pArena->Crit);
+        return(NULL);
+    }
+
+    uModule = _DirtyMemArenaModule(pArena, iMemModule);
+    pHead->uSize = (uint32_t)iSize;
+    pHead->iMemModule = iMemModule;
+    pHead->uArena = (uint16_t)(pArena - _DirtyMemArena.aArenas);
+    pHead->uModule = (uint16_t)uModule;
+
+    _DirtyMemArenaStatUpdate(&pArena->Stat, iSize, 1, 1);
+    if (uModule != DIRTYMEM_ARENA_NOMODULE)
+    {
+        _DirtyMemArenaStatUpdate(&pArena->aModuleStat[uModule], iSize, 1, 1);
+    }
+    NetCritLeave(&pArena->Crit);
+    return(pHead + 1);
+}
+
+/*** Public functions *************************************************************/
+
+/*F********************************************************************************/
+/*!
+    \Function DirtyMemArenaCreate
+
+    \Description
+        Create the arena allocator.
+
+    \Input uFlags   - DIRTYMEM_ARENA_FLAG_*
+
+    \Output
+        int32_t     - zero=success, negative=already created
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+int32_t DirtyMemArenaCreate(uint32_t uFlags)
+{
+    int32_t iArena;
+
+    if (_DirtyMemArena.bCreated)
+    {
+        NetPrintf(("dirtymemarena: already created\n"));
+        return(-1);
+    }
+    memset(&_DirtyMemArena, 0, sizeof(_DirtyMemArena));
+    NetCritInit(&_DirtyMemArena.Crit, "dirtymemarena");
+    for (iArena = 0; iArena < DIRTYMEM_ARENA_MAXGROUPS; iArena += 1)
+    {
+        NetCritInit(&_DirtyMemArena.aArenas[iArena].Crit, "dirtymemarena-group");
+        _DirtyMemArena.aArenas[iArena].uGeneration = __atomic_add_fetch(&_DirtyMemArena_uGeneration, 1, __ATOMIC_RELAXED);
+    }
+    #if DIRTYCODE_PLATFORM == DIRTYCODE_LINUX
+    if ((uFlags & DIRTYMEM_ARENA_FLAG_THREADCACHE) && (pthread_key_create(&_DirtyMemArena.ThreadKey, _DirtyMemArenaThreadExit) != 0))
+    {
+        NetPrintf(("dirtymemarena: unable to register thread exit hook, thread caches disabled\n"));
+        uFlags &= ~DIRTYMEM_ARENA_FLAG_THREADCACHE;
+    }
+    #endif
+    _DirtyMemArena.uFlags = uFlags;
+    _DirtyMemArena.bCreated = TRUE;
+    return(0);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function DirtyMemArenaDestroy
+
+    \Description
+        Destroy the arena allocator, returning all memory to the system.
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+void DirtyMemArenaDestroy(void)
+{
+    int32_t iArena;
+
+    if (!_DirtyMemArena.bCreated)
+    {
+        return;
+    }
+    _DirtyMemArenaCacheFlush(&_DirtyMemArena_Cache);
+    #if DIRTYCODE_PLATFORM == DIRTYCODE_LINUX
+    if (_DirtyMemArena.uFlags & DIRTYMEM_ARENA_FLAG_THREADCACHE)
+    {
+        pthread_key_delete(_DirtyMemArena.ThreadKey);
+    }
+    #endif
+    for (iArena = 0; iArena < DIRTYMEM_ARENA_MAXGROUPS; iArena += 1)
+    {
+        _DirtyMemArenaReset(&_DirtyMemArena.aArenas[iArena]);
+        NetCritKill(&_DirtyMemArena.aArenas[iArena].Crit);
+    }
+    NetCritKill(&_DirtyMemArena.Crit);
+    _DirtyMemArena.bCreated = FALSE;
+}
+
+/*F********************************************************************************/
+/*!
+    \Function DirtyMemArenaRelease
+
+    \Description
+        Release every allocation made in a memory group in one step. Pointers
+        previously returned for the group must not be used or freed afterwards.
+
+    \Input iMemGroup    - memory group to release
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+void DirtyMemArenaRelease(int32_t iMemGroup)
+{
+    DirtyMemArenaT *pArena;
+
+    if ((pArena = _DirtyMemArenaGet(iMemGroup, FALSE)) == NULL)
+    {
+        return;
+    }
+    DirtyMemDebugRelease(iMemGroup);
+    NetCritEnter(&pArena->Crit);
+    _DirtyMemArenaReset(pArena);
+    NetCritLeave(&pArena->Crit);
+
+    NetCritEnter(&_DirtyMemArena.Crit);
+    __atomic_store_n(&pArena->bActive, FALSE, __ATOMIC_RELEASE);
+    NetCritLeave(&_DirtyMemArena.Crit);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function DirtyMemArenaGroupStat
+
+    \Description
+        Get statistics for a memory group.
+
+    \Input iMemGroup    - memory group
+    \Input *pStat       - [out] statistics
+
+    \Output
+        int32_t         - zero=success, negative=group has no arena
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+int32_t DirtyMemArenaGroupStat(int32_t iMemGroup, DirtyMemArenaStatT *pStat)
+{
+    DirtyMemArenaT *pArena;
+
+    memset(pStat, 0, sizeof(*pStat));
+    if ((pArena = _DirtyMemArenaGet(iMemGroup, FALSE)) == NULL)
+    {
+        return(-1);
+    }
+    NetCritEnter(&pArena->Crit);
+    *pStat = pArena->Stat;
+    NetCritLeave(&pArena->Crit);
+    return(0);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function DirtyMemArenaModuleStat
+
+    \Description
+        Get statistics for a module summed across all memory groups. The peak is
+        the sum of the per-group peaks, so it can exceed the true combined peak.
+
+    \Input iMemModule   - module memid
+    \Input *pStat       - [out] statistics
+
+    \Output
+        int32_t         - zero=success, negative=module has not allocated
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+int32_t DirtyMemArenaModuleStat(int32_t iMemModule, DirtyMemArenaStatT *pStat)
+{
+    int32_t iArena, iModule, iResult = -1;
+
+    memset(pStat, 0, sizeof(*pStat));
+    for (iArena = 0; iArena < DIRTYMEM_ARENA_MAXGROUPS; iArena += 1)
+    {
+        DirtyMemArenaT *pArena = &_DirtyMemArena.aArenas[iArena];
+        NetCritEnter(&pArena->Crit);
+        for (iModule = 0; iModule < DIRTYMEM_ARENA_MAXMODULES; iModule += 1)
+        {
+            if (pArena->aModuleIds[iModule] == iMemModule)
+            {
+                pStat->iLiveBytes += pArena->aModuleStat[iModule].iLiveBytes;
+                pStat->iPeakBytes += pArena->aModuleStat[iModule].iPeakBytes;
+                pStat->iLiveCount += pArena->aModuleStat[iModule].iLiveCount;
+                pStat->uTotalAllocs += pArena->aModuleStat[iModule].uTotalAllocs;
+                iResult = 0;
+                break;
+            }
+        }
+        NetCritLeave(&pArena->Crit);
+    }
+    return(iResult);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function DirtyMemAlloc
+
+    \Description
+        Allocate memory from the arena for the given memory group.
+
+    \Input iSize                - size of the allocation
+    \Input iMemModule           - module memid
+    \Input iMemGroup            - memory group
+    \Input *pMemGroupUserData   - memory group user data
+
+    \Output
+        void *                  - 16-byte aligned memory, or NULL on failure
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+void *DirtyMemAlloc(int32_t iSize, int32_t iMemModule, int32_t iMemGroup, void *pMemGroupUserData)
+{
+    void *pMem;
+    if ((pMem = _DirtyMemArenaAlloc(iSize, iMemModule, iMemGroup)) != NULL)
+    {
+        DirtyMemDebugAlloc(pMem, iSize, iMemModule, iMemGroup, pMemGroupUserData);
+    }
+    return(pMem);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function DirtyMemFree
+
+    \Description
+        Free memory allocated with DirtyMemAlloc(). The owning arena is taken from
+        the block header; the module and group parameters are not used.
+
+    \Input *pMem                - memory to free (may be NULL)
+    \Input iMemModule           - module memid
+    \Input iMemGroup            - memory group
+    \Input *pMemGroupUserData   - memory group user data
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+void DirtyMemFree(void *pMem, int32_t iMemModule, int32_t iMemGroup, void *pMemGroupUserData)
+{
+    DirtyMemArenaHeadT *pHead;
+    DirtyMemArenaT *pArena;
+
+    if (pMem == NULL)
+    {
+        return;
+    }
+    pHead = (DirtyMemArenaHeadT *)pMem - 1;
+    pArena = &_DirtyMemArena.aArenas[pHead->uArena];
+    DirtyMemDebugFree(pMem, (int32_t)pHead->uSize, pHead->iMemModule, iMemGroup, pMemGroupUserData);
+
+    if ((_DirtyMemArena.uFlags & DIRTYMEM_ARENA_FLAG_THREADCACHE) && (pHead->uClass < DIRTYMEM_ARENA_CACHECLASSES))
+    {
+        _DirtyMemArenaCacheFree(pArena, pHead);
+        return;
+    }
+
+    NetCritEnter(&pArena->Crit);
+    _DirtyMemArenaStatUpdate(&pArena->Stat, -(int64_t)pHead->uSize, -1, 0);
+    if (pHead->uModule != DIRTYMEM_ARENA_NOMODULE)
+    {
+        _DirtyMemArenaStatUpdate(&pArena->aModuleStat[pHead->uModule], -(int64_t)pHead->uSize, -1, 0);
+    }
+    if (pHead->uClass != DIRTYMEM_ARENA_LARGE)
+    {
+        _DirtyMemArenaBlockFree(pArena, pHead);
+    }
+    else
+    {
+        DirtyMemArenaLargeT *pLarge = (DirtyMemArenaLargeT *)((uint8_t *)pHead - offsetof(DirtyMemArenaLargeT, Head));
+        if (pLarge->pNext != NULL)
+        {
+            pLarge->pNext->pPrev = pLarge->pPrev;
+        }
+        if (pLarge->pPrev != NULL)
+        {
+            pLarge->pPrev->pNext = pLarge->pNext;
+        }
+        else
+        {
+            pArena->pLarge = pLarge->pNext;
+        }
+        pArena->Stat.iReservedBytes -= sizeof(*pLarge) + pHead->uSize;
+        free(pLarge);
+    }
+    NetCritLeave(&pArena->Crit);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function DirtyMemArenaThreadFlush
+
+    \Description
+        Return the calling thread's cached blocks and pending statistics to the
+        arenas. Threads should call this before exiting on platforms without a
+        thread exit hook, and before reading statistics that must be exact.
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+void DirtyMemArenaThreadFlush(void)
+{
+    if (_DirtyMemArena.uFlags & DIRTYMEM_ARENA_FLAG_THREADCACHE)
+    {
+        _DirtyMemArenaCacheFlush(&_DirtyMemArena_Cache);
+    }
+}
@@ -0,0 +1,81 @@
+/*H********************************************************************************/
+/*!
+    \File dirtymemarena.h
+
+    \Description
+        Reference DirtyMemAlloc()/DirtyMemFree() backend. Each memory group gets its
+        own arena with size-class free lists, so a whole group can be released in
+        one call and usage can be reported per group and per module.
+
+    \Notes
+        Link dirtymemarena.c instead of supplying DirtyMemAlloc()/DirtyMemFree() in
+        the application. DirtyMemArenaCreate() must be called before the first
+        allocation and DirtyMemArenaDestroy() after the last free.
+
+    \Version 10/18/2026 (agent) First Version
+*/
+/********************************************************************************H*/
+
+#ifndef _dirtymemarena_h
+#define _dirtymemarena_h
+
+/*** Include files ****************************************************************/
+
+#include "platform.h"
+
+/*** Defines **********************************************************************/
+
+//! maximum number of memory groups that can have an arena at the same time
+#define DIRTYMEM_ARENA_MAXGROUPS    (16)
+
+//! maximum number of modules tracked per arena
+#define DIRTYMEM_ARENA_MAXMODULES   (64)
+
+//! DirtyMemArenaCreate() flag - back arena chunks with huge pages where available
+#define DIRTYMEM_ARENA_FLAG_HUGEPAGES   (1)
+
+//! DirtyMemArenaCreate() flag - keep per-thread caches of small blocks
+#define DIRTYMEM_ARENA_FLAG_THREADCACHE (2)
+
+/*** Type Definitions *************************************************************/
+
+/*! usage statistics for one memory group or one module; signed because, with thread
+    caches enabled, frees can be applied before the matching allocations are */
+typedef struct DirtyMemArenaStatT
+{
+    int64_t iLiveBytes;         //!< bytes currently allocated (requested sizes)
+    int64_t iPeakBytes;         //!< high-water mark of iLiveBytes
+    int64_t iReservedBytes;     //!< bytes reserved from the system (groups only)
+    int32_t iLiveCount;         //!< number of live allocations
+    uint32_t uTotalAllocs;      //!< number of allocations since creation/release
+} DirtyMemArenaStatT;
+
+/*** Functions ********************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// create the arena allocator
+int32_t DirtyMemArenaCreate(uint32_t uFlags);
+
+// destroy the arena allocator, releasing every group
+void DirtyMemArenaDestroy(void);
+
+// release every allocation made in a memory group
+void DirtyMemArenaRelease(int32_t iMemGroup);
+
+// get statistics for a memory group
+int32_t DirtyMemArenaGroupStat(int32_t iMemGroup, DirtyMemArenaStatT *pStat);
+
+// get statistics for a module, summed across all groups
+int32_t DirtyMemArenaModuleStat(int32_t iMemModule, DirtyMemArenaStatT *pStat);
+
+// return the calling thread's cached blocks and pending statistics to the arenas
+void DirtyMemArenaThreadFlush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dirtymemarena_h
@@ -0,0 +1,291 @@
+/*H********************************************************************************/
+/*!
+    \File dirtynet.c
+
+    \Description
+        Platform independent network helpers: IPv4 address text conversion.
+
+    \Notes
+        Addresses are parsed and formatted without the C library. Parsing accepts
+        dotted-quad text ("192.168.1.90") and the eight-digit "$c0a8015a" hex form
+        used in connect strings. Formatting copies each octet's digits from a
+        256-entry table rather than dividing.
+
+    \Version 10/18/2026 (agent) First Version
+*/
+/********************************************************************************H*/
+
+/*** Include files ****************************************************************/
+
+#include <string.h>
+
+#include "dirtysock.h"
+
+/*** Defines **********************************************************************/
+
+/*** Type Definitions *************************************************************/
+
+/*** Variables ********************************************************************/
+
+//! decimal text of each octet value, NUL padded, with the digit count in the last byte
+static const char _SocketInOctetText[256][4] =
+{
+    {'0',0,0,1}, {'1',0,0,1}, {'2',0,0,1}, {'3',0,0,1}, {'4',0,0,1}, {'5',0,0,1}, {'6',0,0,1}, {'7',0,0,1},
+    {'8',0,0,1}, {'9',0,0,1}, {'1','0',0,2}, {'1','1',0,2}, {'1','2',0,2}, {'1','3',0,2}, {'1','4',0,2}, {'1','5',0,2},
+    {'1','6',0,2}, {'1','7',0,2}, {'1','8',0,2}, {'1','9',0,2}, {'2','0',0,2}, {'2','1',0,2}, {'2','2',0,2}, {'2','3',0,2},
+    {'2','4',0,2}, {'2','5',0,2}, {'2','6',0,2}, {'2','7',0,2}, {'2','8',0,2}, {'2','9',0,2}, {'3','0',0,2}, {'3','1',0,2},
+    {'3','2',0,2}, {'3','3',0,2}, {'3','4',0,2}, {'3','5',0,2}, {'3','6',0,2}, {'3','7',0,2}, {'3','8',0,2}, {'3','9',0,2},
+    {'4','0',0,2}, {'4','1',0,2}, {'4','2',0,2}, {'4','3',0,2}, {'4','4',0,2}, {'4','5',0,2}, {'4','6',0,2}, {'4','7',0,2},
+    {'4','8',0,2}, {'4','9',0,2}, {'5','0',0,2}, {'5','1',0,2}, {'5','2',0,2}, {'5','3',0,2}, {'5','4',0,2}, {'5','5',0,2},
+    {'5','6',0,2}, {'5','7',0,2}, {'5','8',0,2}, {'5','9',0,2}, {'6','0',0,2}, {'6','1',0,2}, {'6','2',0,2}, {'6','3',0,2},
+    {'6','4',0,2}, {'6','5',0,2}, {'6','6',0,2}, {'6','7',0,2}, {'6','8',0,2}, {'6','9',0,2}, {'7','0',0,2}, {'7','1',0,2},
+    {'7','2',0,2}, {'7','3',0,2}, {'7','4',0,2}, {'7','5',0,2}, {'7','6',0,2}, {'7','7',0,2}, {'7','8',0,2}, {'7','9',0,2},
+    {'8','0',0,2}, {'8','1',0,2}, {'8','2',0,2}, {'8','3',0,2}, {'8','4',0,2}, {'8','5',0,2}, {'8','6',0,2}, {'8','7',0,2},
+    {'8','8',0,2}, {'8','9',0,2}, {'9','0',0,2}, {'9','1',0,2}, {'9','2',0,2}, {'9','3',0,2}, {'9','4',0,2}, {'9','5',0,2},
+    {'9','6',0,2}, {'9','7',0,2}, {'9','8',0,2}, {'9','9',0,2}, {'1','0','0',3}, {'1','0','1',3}, {'1','0','2',3}, {'1','0','3',3},
+    {'1','0','4',3}, {'1','0','5',3}, {'1','0','6',3}, {'1','0','7',3}, {'1','0','8',3}, {'1','0','9',3}, {'1','1','0',3}, {'1','1','1',3},
+    {'1','1','2',3}, {'1','1','3',3}, {'1','1','4',3}, {'1','1','5',3}, {'1','1','6',3}, {'1','1','7',3}, {'1','1','8',3}, {'1','1','9',3},
+    {'1','2','0',3}, {'1','2','1',3}, {'1','2','2',3}, {'1','2','3',3}, {'1','2','4',3}, {'1','2','5',3}, {'1','2','6',3}, {'1','2','7',3},
+    {'1','2','8',3}, {'1','2','9',3}, {'1','3','0',3}, {'1','3','1',3}, {'1','3','2',3}, {'1','3','3',3}, {'1','3','4',3}, {'1','3','5',3},
+    {'1','3','6',3}, {'1','3','7',3}, {'1','3','8',3}, {'1','3','9',3}, {'1','4','0',3}, {'1','4','1',3}, {'1','4','2',3}, {'1','4','3',3},
+    {'1','4','4',3}, {'1','4','5',3}, {'1','4','6',3}, {'1','4','7',3}, {'1','4','8',3}, {'1','4','9',3}, {'1','5','0',3}, {'1','5','1',3},
+    {'1','5','2',3}, {'1','5','3',3}, {'1','5','4',3}, {'1','5','5',3}, {'1','5','6',3}, {'1','5','7',3}, {'1','5','8',3}, {'1','5','9',3},
+    {'1','6','0',3}, {'1','6','1',3}, {'1','6','2',3}, {'1','6','3',3}, {'1','6','4',3}, {'1','6','5',3}, {'1','6','6',3}, {'1','6','7',3},
+    {'1','6','8',3}, {'1','6','9',3}, {'1','7','0',3}, {'1','7','1',3}, {'1','7','2',3}, {'1','7','3',3}, {'1','7','4',3}, {'1','7','5',3},
+    {'1','7','6',3}, {'1','7','7',3}, {'1','7','8',3}, {'1','7','9',3}, {'1','8','0',3}, {'1','8','1',3}, {'1','8','2',3}, {'1','8','3',3},
+    {'1','8','4',3}, {'1','8','5',3}, {'1','8','6',3}, {'1','8','7',3}, {'1','8','8',3}, {'1','8','9',3}, {'1','9','0',3}, {'1','9','1',3},
+    {'1','9','2',3}, {'1','9','3',3}, {'1','9','4',3}, {'1','9','5',3}, {'1','9','6',3}, {'1','9','7',3}, {'1','9','8',3}, {'1','9','9',3},
+    {'2','0','0',3}, {'2','0','1',3}, {'2','0','2',3}, {'2','0','3',3}, {'2','0','4',3}, {'2','0','5',3}, {'2','0','6',3}, {'2','0','7',3},
+    {'2','0','8',3}, {'2','0','9',3}, {'2','1','0',3}, {'2','1','1',3}, {'2','1','2',3}, {'2','1','3',3}, {'2','1','4',3}, {'2','1','5',3},
+    {'2','1','6',3}, {'2','1','7',3}, {'2','1','8',3}, {'2','1','9',3}, {'2','2','0',3}, {'2','2','1',3}, {'2','2','2',3}, {'2','2','3',3},
+    {'2','2','4',3}, {'2','2','5',3}, {'2','2','6',3}, {'2','2','7',3}, {'2','2','8',3}, {'2','2','9',3}, {'2','3','0',3}, {'2','3','1',3},
+    {'2','3','2',3}, {'2','3','3',3}, {'2','3','4',3}, {'2','3','5',3}, {'2','3','6',3}, {'2','3','7',3}, {'2','3','8',3}, {'2','3','9',3},
+    {'2','4','0',3}, {'2','4','1',3}, {'2','4','2',3}, {'2','4','3',3}, {'2','4','4',3}, {'2','4','5',3}, {'2','4','6',3}, {'2','4','7',3},
+    {'2','4','8',3}, {'2','4','9',3}, {'2','5','0',3}, {'2','5','1',3}, {'2','5','2',3}, {'2','5','3',3}, {'2','5','4',3}, {'2','5','5',3}
+};
+
+/*** Private Functions ************************************************************/
+
+/*F********************************************************************************/
+/*!
+    \Function _SocketInAddrFormat
+
+    \Description
+        Format an IPv4 address as dotted-quad text.
+
+    \Input uAddr    - address, host order
+    \Input *pText   - [out] text buffer, at least 16 bytes
+
+    \Output
+        int32_t     - length of the text, excluding the terminator
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+static int32_t _SocketInAddrFormat(uint32_t uAddr, char *pText)
+{
+    char *pOut = pText;
+    int32_t iShift;
+
+    // copy all four table bytes, then advance by the digit count so the padding is overwritten
+    for (iShift = 24; iShift >= 0; iShift -= 8)
+    {
+        const char *pOctet = _SocketInOctetText[(uAddr >> iShift) & 0xff];
+        memcpy(pOut, pOctet, 4);
+        pOut += pOctet[3];
+        *pOut++ = '.';
+    }
+    *--pOut = '\0';
+    return((int32_t)(pOut - pText));
+}
+
+/*** Public functions *************************************************************/
+
+/*F********************************************************************************/
+/*!
+    \Function SockaddrInSetAddrText
+
+    \Description
+        Set the address of a sockaddr from dotted-quad or $hex text.
+
+    \Input *addr    - sockaddr to update
+    \Input *str     - address text
+
+    \Output
+        int32_t     - zero=success, negative=text is not an address (sockaddr unchanged)
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+int32_t SockaddrInSetAddrText(struct sockaddr *addr, const char *str)
+{
+    uint32_t uAddr;
+    if (((str = SocketInTextParse(str, &uAddr)) == NULL) || (*str != '\0'))
+    {
+        return(-1);
+    }
+    SockaddrInSetAddr(addr, uAddr);
+    return(0);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function SockaddrInGetAddrText
+
+    \Description
+        Get the address of a sockaddr as dotted-quad text.
+
+    \Input *addr    - sockaddr
+    \Input *str     - [out] text buffer
+    \Input len      - size of text buffer; the text is truncated to fit
+
+    \Output
+        char *      - str
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+char *SockaddrInGetAddrText(struct sockaddr *addr, char *str, int32_t len)
+{
+    return(SocketInAddrGetText(SockaddrInGetAddr(addr), str, len));
+}
+
+/*F********************************************************************************/
+/*!
+    \Function SocketInAddrGetText
+
+    \Description
+        Convert a 32-bit address to dotted-quad text.
+
+    \Input addr     - address, host order
+    \Input *str     - [out] text buffer
+    \Input len      - size of text buffer; the text is truncated to fit
+
+    \Output
+        char *      - str
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+char *SocketInAddrGetText(uint32_t addr, char *str, int32_t len)
+{
+    char strText[16];
+    int32_t iLength;
+
+    if (len <= 0)
+    {
+        return(str);
+    }
+    if (len >= (int32_t)sizeof(strText))
+    {
+        _SocketInAddrFormat(addr, str);
+        return(str);
+    }
+    iLength = _SocketInAddrFormat(addr, strText);
+    iLength = (iLength < len) ? iLength : len - 1;
+    memcpy(str, strText, iLength);
+    str[iLength] = '\0';
+    return(str);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function SocketInTextGetAddr
+
+    \Description
+        Convert dotted-quad or $hex text to a 32-bit address.
+
+    \Input *addrtext    - address text
+
+    \Output
+        int32_t         - address, host order, or zero if the text is not an address
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+int32_t SocketInTextGetAddr(const char *addrtext)
+{
+    uint32_t uAddr;
+    if (((addrtext = SocketInTextParse(addrtext, &uAddr)) == NULL) || (*addrtext != '\0'))
+    {
+        return(0);
+    }
+    return((int32_t)uAddr);
+}
+
+/*F********************************************************************************/
+/*!
+    \Function SocketInTextParse
+
+    \Description
+        Parse a dotted-quad or $hex IPv4 address at the start of a string. Like
+        inet_pton(), octets with a leading zero ("01") are rejected rather than read
+        as octal or decimal. A $hex address is exactly eight hex digits; the caller
+        checks what follows the returned pointer.
+
+    \Input *pText   - address text
+    \Input *pAddr   - [out] address, host order
+
+    \Output
+        const char *    - pointer past the parsed address, or NULL if the text is not an address
+
+    \Version 10/18/2026 (agent)
+*/
+/********************************************************************************F*/
+const char *SocketInTextParse(const char *pText, uint32_t *pAddr)
+{
+    uint32_t uAddr = 0, uDigit, uOctet;
+    int32_t iOctet;
+
+    // $hex form, as used in connect strings
+    if (*pText == '$')
+    {
+        for (iOctet = 0, pText += 1; iOctet < 8; iOctet += 1, pText += 1)
+        {
+            if ((uDigit = (uint8_t)*pText - '0') > 9)
+            {
+                if ((uDigit = ((uint8_t)*pText | 0x20) - 'a') > 5)
+                {
+                    return(NULL);
+                }
+                uDigit += 10;
+            }
+            uAddr = (uAddr << 4) | uDigit;
+        }
+        *pAddr = uAddr;
+        return(pText);
+    }
+
+    // dotted quad; one to three digits per octet, no leading zero
+    for (iOctet = 0; iOctet < 4; iOctet += 1)
+    {
+        if ((iOctet > 0) && (*pText++ != '.'))
+        {
+            return(NULL);
+        }
+        if ((uOctet = (uint8_t)*pText - '0') > 9)
+        {
+            return(NULL);
+        }
+        if ((uDigit = (uint8_t)*++pText - '0') <= 9)
+        {
+            if (uOctet == 0)
+            {
+                return(NULL);
+            }
+            uOctet = (uOctet * 10) + uDigit;
+            if ((uDigit = (uint8_t)*++pText - '0') <= 9)
+            {
+                uOctet = (uOctet * 10) + uDigit;
+                pText += 1;
+            }
+        }
+        if (uOctet > 255)
+        {
+            return(NULL);
+        }
+        uAddr = (uAddr << 8) | uOctet;
+    }
+    *pAddr = uAddr;
+    return(pText);
+}
@@ -140,13 +140,13 @@
 #define SockaddrInSetPort(addr,val) { (addr)->sa_data[0] = (unsigned char)((val)>>8); (addr)->sa_data[1] = (unsigned char)(val); }
 
 //! get the address in host format from sockaddr
-#define SockaddrInGetAddr(addr)     (((((((unsigned char)((addr)->sa_data[2])<<8)|(unsigned char)((addr)->sa_data[3]))<<8)|(unsigned char)((addr)->sa_data[4]))<<8)|(unsigned char)((addr)->sa_data[5]))
+#define SockaddrInGetAddr(addr)     (((((((uint32_t)(unsigned char)((addr)->sa_data[2])<<8)|(unsigned char)((addr)->sa_data[3]))<<8)|(unsigned char)((addr)->sa_data[4]))<<8)|(unsigned char)((addr)->sa_data[5]))
 
 //! set the address in host format in a sockaddr
 #define SockaddrInSetAddr(addr,val) { uint32_t val2 = (val); (addr)->sa_data[5] = (unsigned char)val2; val2 >>= 8; (addr)->sa_data[4] = (unsigned char)val2; val2 >>= 8; (addr)->sa_data[3] = (unsigned char)val2; val2 >>= 8; (addr)->sa_data[2] = (unsigned char)val2; }
 
 //! get the misc field in host format from sockaddr
-#define SockaddrInGetMisc(addr)     (((((((unsigned char)((addr)->sa_data[6])<<8)|(unsigned char)((addr)->sa_data[7]))<<8)|(unsigned char)((addr)->sa_data[8]))<<8)|(unsigned char)((addr)->sa_data[9]))
+#define SockaddrInGetMisc(addr)     (((((((uint32_t)(unsigned char)((addr)->sa_data[6])<<8)|(unsigned char)((addr)->sa_data[7]))<<8)|(unsigned char)((addr)->sa_data[8]))<<8)|(unsigned char)((addr)->sa_data[9]))
 
 //! set the misc field in host format in a sockaddr
 #define SockaddrInSetMisc(addr,val) { uint32_t val2 = (val); (addr)->sa_data[9] = (unsigned char)val2; val2 >>= 8; (addr)->sa_data[8] = (unsigned char)val2; val2 >>= 8; (addr)->sa_data[7] = (unsigned char)val2; val2 >>= 8; (addr)->sa_data[6] = (unsigned char)val2; }
@@ -275,6 +275,9 @@ char *SocketInAddrGetText(uint32_t addr, char *str, int32_t len);
 // convert textual internet address into 32-bit integer form
 int32_t SocketInTextGetAddr(const char *addrtext);
 
+// parse a dotted-quad or $hex address at the start of a string, returning a pointer past it
+const char *SocketInTextParse(const char *pText, uint32_t *pAddr);
+
 // parse address:port combination
 int32_t SockaddrInParse(struct sockaddr *addr, const char *parse);
 
@@ -168,6 +168,13 @@
  #endif
 #endif
 
+// thread local storage qualifier
+#if defined(_MSC_VER)
+ #define DIRTYCODE_THREADLOCAL __declspec(thread)
+#else
+ #define DIRTYCODE_THREADLOCAL __thread
+#endif
+
 /*** Macros ***********************************************************************/
 
 /*! macros to redefine common function names to their dirtysock functional
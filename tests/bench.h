@@ -0,0 +1,136 @@
+#ifndef _bench_h
+#define _bench_h
+
+/*
+    Minimal microbenchmark harness shared by the bench_v*.c files.
+
+    Each benchmark is a function that runs its operation iIters times. The
+    harness warms it up, then times BENCH_REPS repetitions and reports
+    min/median/mean/stddev ns per op. On Linux it also reports cycles per op
+    from perf_event when the kernel allows it, otherwise that column is "-".
+
+    Build with optimizations, e.g.:
+        gcc -O2 -Wno-multichar bench_v5.6.2.c -o bench -lm -lpthread && ./bench
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#define BENCH_WARMUP_NS (50*1000*1000)   // spend ~50ms warming up and calibrating
+#define BENCH_REP_NS    (20*1000*1000)   // target ~20ms per timed repetition
+#define BENCH_REPS      (15)
+
+typedef void (BenchFuncT)(void *pRef, int32_t iIters);
+
+//! sink used by benchmarks to keep results observable
+static volatile uint32_t g_uBenchSink;
+
+static int g_iBenchCycleFd = -2;
+
+static uint64_t _BenchNsec(void)
+{
+    struct timespec Now;
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+    return((uint64_t)Now.tv_sec * 1000000000ull + (uint64_t)Now.tv_nsec);
+}
+
+static int _BenchCycleFd(void)
+{
+    #if defined(__linux__)
+    if (g_iBenchCycleFd == -2)
+    {
+        struct perf_event_attr Attr;
+        memset(&Attr, 0, sizeof(Attr));
+        Attr.type = PERF_TYPE_HARDWARE;
+        Attr.size = sizeof(Attr);
+        Attr.config = PERF_COUNT_HW_CPU_CYCLES;
+        Attr.exclude_kernel = 1;
+        Attr.exclude_hv = 1;
+        g_iBenchCycleFd = (int)syscall(SYS_perf_event_open, &Attr, 0, -1, -1, 0);
+    }
+    #else
+    g_iBenchCycleFd = -1;
+    #endif
+    return(g_iBenchCycleFd);
+}
+
+static uint64_t _BenchCycles(void)
+{
+    #if defined(__linux__)
+    uint64_t uCycles = 0;
+    if ((_BenchCycleFd() >= 0) && (read(g_iBenchCycleFd, &uCycles, sizeof(uCycles)) == sizeof(uCycles)))
+    {
+        return(uCycles);
+    }
+    #endif
+    return(0);
+}
+
+static int _BenchCompare(const void *pA, const void *pB)
+{
+    double fA = *(const double *)pA, fB = *(const double *)pB;
+    return((fA > fB) - (fA < fB));
+}
+
+static void BenchRun(const char *pName, BenchFuncT *pFunc, void *pRef)
+{
+    double aNsPerOp[BENCH_REPS], fMean = 0.0, fDev = 0.0, fCycles = 0.0;
+    uint64_t uStart, uCycles;
+    int32_t iIters, iRep;
+
+    // warm up while doubling the iteration count until one run takes a measurable time
+    for (iIters = 16; ; iIters *= 2)
+    {
+        uStart = _BenchNsec();
+        pFunc(pRef, iIters);
+        if ((_BenchNsec() - uStart) >= (BENCH_WARMUP_NS/8))
+        {
+            break;
+        }
+    }
+    iIters = (int32_t)((double)iIters * BENCH_REP_NS / (double)(_BenchNsec() - uStart) + 1);
+
+    for (iRep = 0; iRep < BENCH_REPS; iRep += 1)
+    {
+        uCycles = _BenchCycles();
+        uStart = _BenchNsec();
+        pFunc(pRef, iIters);
+        aNsPerOp[iRep] = (double)(_BenchNsec() - uStart) / iIters;
+        fCycles += (double)(_BenchCycles() - uCycles) / iIters;
+        fMean += aNsPerOp[iRep];
+    }
+    fMean /= BENCH_REPS;
+    for (iRep = 0; iRep < BENCH_REPS; iRep += 1)
+    {
+        fDev += (aNsPerOp[iRep] - fMean) * (aNsPerOp[iRep] - fMean);
+    }
+    fDev = sqrt(fDev / (BENCH_REPS - 1));
+    qsort(aNsPerOp, BENCH_REPS, sizeof(aNsPerOp[0]), _BenchCompare);
+
+    printf("%-40s %9.2f %9.2f %9.2f %8.2f", pName, aNsPerOp[0], aNsPerOp[BENCH_REPS/2], fMean, fDev);
+    if (g_iBenchCycleFd >= 0)
+    {
+        printf(" %9.2f\n", fCycles / BENCH_REPS);
+    }
+    else
+    {
+        printf(" %9s\n", "-");
+    }
+}
+
+static void BenchHeader(const char *pTitle)
+{
+    printf("%s\n", pTitle);
+    printf("%-40s %9s %9s %9s %8s %9s\n", "benchmark", "min ns", "median ns", "mean ns", "stddev", "cycles");
+}
+
+#endif // _bench_h
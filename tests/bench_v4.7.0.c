@@ -0,0 +1,95 @@
+#include <stdio.h>
+#include <string.h>
+#include "../4.7.0/commudp.c"
+#include "bench.h"
+
+#define BENCH_NUMCONN (64)
+
+static char g_aConnStr[BENCH_NUMCONN][64];
+
+static void _BenchInitConnStr(void)
+{
+    int32_t iConn;
+    for (iConn = 0; iConn < BENCH_NUMCONN; iConn++) {
+        uint32_t uAddr = 0xc0a80100 + iConn;
+        sprintf(g_aConnStr[iConn], "192.168.1.%d:3659:3659#$%08x$%08x-$%08x$%08x", iConn, uAddr, uAddr, uAddr+1, uAddr+1);
+    }
+}
+
+static void bench_CommUDPSetConnID(void *pRef, int32_t iIters) {
+    CommUDPRef ref;
+    int32_t iIter;
+    memset(&ref, 0, sizeof(CommUDPRef));
+    for (iIter = 0; iIter < iIters; iIter++) {
+        _CommUDPSetConnID(&ref, g_aConnStr[iIter % BENCH_NUMCONN]);
+        g_uBenchSink += ref.connident;
+    }
+}
+
+static void bench_CommUDPParseConnStr(void *pRef, int32_t iIters) {
+    CommUDPConnStrT ConnStr;
+    int32_t iIter;
+    for (iIter = 0; iIter < iIters; iIter++) {
+        _CommUDPParseConnStr(g_aConnStr[iIter % BENCH_NUMCONN], &ConnStr);
+        g_uBenchSink += ConnStr.uAddr + ConnStr.iPort + ConnStr.uConnIdent + ConnStr.aAddr[3];
+    }
+}
+
+//! the same fields decoded the current way: sscanf (as common/utils.c ip_to_hex) plus _CommUDPSetConnID
+static void bench_ConnStrSscanf(void *pRef, int32_t iIters) {
+    CommUDPRef ref;
+    uint32_t a, b, c, d, aAddr[4];
+    int32_t iIter, iPort, iPort2;
+    memset(&ref, 0, sizeof(CommUDPRef));
+    for (iIter = 0; iIter < iIters; iIter++) {
+        const char *pStrConn = g_aConnStr[iIter % BENCH_NUMCONN];
+        sscanf(pStrConn, "%u.%u.%u.%u:%d:%d", &a, &b, &c, &d, &iPort, &iPort2);
+        sscanf(strchr(pStrConn, '#'), "#$%8x$%8x-$%8x$%8x", &aAddr[0], &aAddr[1], &aAddr[2], &aAddr[3]);
+        _CommUDPSetConnID(&ref, pStrConn);
+        g_uBenchSink += ((a << 24) | (b << 16) | (c << 8) | d) + iPort + ref.connident + aAddr[3];
+    }
+}
+
+static void bench_SockaddrInGetAddr(void *pRef, int32_t iIters) {
+    struct sockaddr addr;
+    int32_t iIter;
+    SockaddrInit(&addr, AF_INET);
+    SockaddrInSetAddr(&addr, 0xc0a8015a);
+    for (iIter = 0; iIter < iIters; iIter++) {
+        addr.sa_data[5] = (unsigned char)iIter;
+        g_uBenchSink += SockaddrInGetAddr(&addr);
+    }
+}
+
+static void bench_SockaddrInSetAddr(void *pRef, int32_t iIters) {
+    struct sockaddr addr;
+    int32_t iIter;
+    SockaddrInit(&addr, AF_INET);
+    for (iIter = 0; iIter < iIters; iIter++) {
+        SockaddrInSetAddr(&addr, 0xc0a80100 + iIter);
+        g_uBenchSink += addr.sa_data[5];
+    }
+}
+
+static void bench_SockaddrInPort(void *pRef, int32_t iIters) {
+    struct sockaddr addr;
+    int32_t iIter;
+    SockaddrInit(&addr, AF_INET);
+    for (iIter = 0; iIter < iIters; iIter++) {
+        SockaddrInSetPort(&addr, iIter);
+        g_uBenchSink += SockaddrInGetPort(&addr);
+    }
+}
+
+int main(void) {
+    _BenchInitConnStr();
+
+    BenchHeader("v4.7.0 primitives");
+    BenchRun("_CommUDPSetConnID", bench_CommUDPSetConnID, NULL);
+    BenchRun("_CommUDPParseConnStr", bench_CommUDPParseConnStr, NULL);
+    BenchRun("sscanf + _CommUDPSetConnID", bench_ConnStrSscanf, NULL);
+    BenchRun("SockaddrInGetAddr", bench_SockaddrInGetAddr, NULL);
+    BenchRun("SockaddrInSetAddr", bench_SockaddrInSetAddr, NULL);
+    BenchRun("SockaddrInSetPort+SockaddrInGetPort", bench_SockaddrInPort, NULL);
+    return 0;
+}
@@ -0,0 +1,519 @@
+#define DIRTYCODE_MEMTRACK (1)
+#define DIRTYCODE_LOGGING (1)
+#define DIRTYCODE_LOGLEVELS NETLOG_THRESHOLD(SOCKET_MEMID, NETLOG_WARNING)
+
+#include <stdio.h>
+#include <string.h>
+#include "../5.6.2/commudp.c"
+#include "../5.6.2/dirtylib.c"
+#include "../5.6.2/dirtymem.c"
+#include "../5.6.2/dirtynet.c"
+#include "../5.6.2/dirtymemarena.c"
+#include "dirtylibstub.h"
+#include "bench.h"
+
+// libc reference conversions; declared here since dirtynet.h has its own sockaddr definitions
+int inet_pton(int af, const char *src, void *dst);
+const char *inet_ntop(int af, const void *src, char *dst, unsigned int size);
+
+#define BENCH_NUMCONN (64)
+
+static char g_aConnStr[BENCH_NUMCONN][64];
+static const char *g_aConnTail[BENCH_NUMCONN];     //!< connident part of each connect string
+static char g_aAddrText[BENCH_NUMCONN][16];         //!< dotted-quad addresses of mixed lengths
+static uint32_t g_aAddr[BENCH_NUMCONN];
+
+static void _BenchInitConnStr(void)
+{
+    int32_t iConn;
+    for (iConn = 0; iConn < BENCH_NUMCONN; iConn++) {
+        uint32_t uAddr = 0xc0a80100 + iConn;
+        sprintf(g_aConnStr[iConn], "192.168.1.%d:3659:3659#$%08x$%08x-$%08x$%08x", iConn, uAddr, uAddr, uAddr+1, uAddr+1);
+        g_aConnTail[iConn] = strchr(g_aConnStr[iConn], '#')+1;
+        g_aAddr[iConn] = (uAddr * 2654435761u) >> (iConn % 8);
+        sprintf(g_aAddrText[iConn], "%u.%u.%u.%u", g_aAddr[iConn] >> 24, (g_aAddr[iConn] >> 16) & 0xff, (g_aAddr[iConn] >> 8) & 0xff, g_aAddr[iConn] & 0xff);
+    }
+}
+
+static void bench_CommUDPSetConnID(void *pRef, int32_t iIters) {
+    CommUDPRef ref;
+    int32_t iIter;
+    memset(&ref, 0, sizeof(CommUDPRef));
+    for (iIter = 0; iIter < iIters; iIter++) {
+        _CommUDPSetConnID(&ref, g_aConnStr[iIter % BENCH_NUMCONN]);
+        g_uBenchSink += ref.connident;
+    }
+}
+
+static void bench_CommUDPParseConnStr(void *pRef, int32_t iIters) {
+    CommUDPConnStrT ConnStr;
+    int32_t iIter;
+    for (iIter = 0; iIter < iIters; iIter++) {
+        _CommUDPParseConnStr(g_aConnStr[iIter % BENCH_NUMCONN], &ConnStr);
+        g_uBenchSink += ConnStr.uAddr + ConnStr.iPort + ConnStr.uConnIdent + ConnStr.aAddr[3];
+    }
+}
+
+//! the same fields decoded the current way: sscanf (as common/utils.c ip_to_hex) plus _CommUDPSetConnID
+static void bench_ConnStrSscanf(void *pRef, int32_t iIters) {
+    CommUDPRef ref;
+    uint32_t a, b, c, d, aAddr[4];
+    int32_t iIter, iPort, iPort2;
+    memset(&ref, 0, sizeof(CommUDPRef));
+    for (iIter = 0; iIter < iIters; iIter++) {
+        const char *pStrConn = g_aConnStr[iIter % BENCH_NUMCONN];
+        sscanf(pStrConn, "%u.%u.%u.%u:%d:%d", &a, &b, &c, &d, &iPort, &iPort2);
+        sscanf(strchr(pStrConn, '#'), "#$%8x$%8x-$%8x$%8x", &aAddr[0], &aAddr[1], &aAddr[2], &aAddr[3]);
+        _CommUDPSetConnID(&ref, pStrConn);
+        g_uBenchSink += ((a << 24) | (b << 16) | (c << 8) | d) + iPort + ref.connident + aAddr[3];
+    }
+}
+
+static void bench_NetHash(void *pRef, int32_t iIters) {
+    int32_t iIter;
+    for (iIter = 0; iIter < iIters; iIter++) {
+        g_uBenchSink += NetHash(strchr(g_aConnStr[iIter % BENCH_NUMCONN], '#')+1);
+    }
+}
+
+static void bench_NetHashLoop(void *pRef, int32_t iIters) {
+    int32_t iIter, iConn;
+    for (iIter = 0; iIter < iIters; iIter += BENCH_NUMCONN) {
+        for (iConn = 0; iConn < BENCH_NUMCONN; iConn++) {
+            g_uBenchSink += NetHash(g_aConnTail[iConn]);
+        }
+    }
+}
+
+static void bench_NetHashBatch(void *pRef, int32_t iIters) {
+    int32_t aHashes[BENCH_NUMCONN], iIter;
+    for (iIter = 0; iIter < iIters; iIter += BENCH_NUMCONN) {
+        NetHashBatch(g_aConnTail, aHashes, BENCH_NUMCONN);
+        g_uBenchSink += aHashes[iIter % BENCH_NUMCONN];
+    }
+}
+
+static void bench_NetHash64(void *pRef, int32_t iIters) {
+    int32_t iIter;
+    for (iIter = 0; iIter < iIters; iIter++) {
+        const char *pTail = g_aConnTail[iIter % BENCH_NUMCONN];
+        g_uBenchSink += (uint32_t)NetHash64(pTail, (int32_t)strlen(pTail), 0x9e3779b97f4a7c15ull);
+    }
+}
+
+static void bench_SocketInTextGetAddr(void *pRef, int32_t iIters) {
+    int32_t iIter;
+    for (iIter = 0; iIter < iIters; iIter++) {
+        g_uBenchSink += SocketInTextGetAddr(g_aAddrText[iIter % BENCH_NUMCONN]);
+    }
+}
+
+static void bench_InetPton(void *pRef, int32_t iIters) {
+    uint32_t uAddr;
+    int32_t iIter;
+    for (iIter = 0; iIter < iIters; iIter++) {
+        inet_pton(AF_INET, g_aAddrText[iIter % BENCH_NUMCONN], &uAddr);
+        g_uBenchSink += uAddr;
+    }
+}
+
+static void bench_SscanfAddr(void *pRef, int32_t iIters) {
+    uint32_t a, b, c, d;
+    int32_t iIter;
+    for (iIter = 0; iIter < iIters; iIter++) {
+        sscanf(g_aAddrText[iIter % BENCH_NUMCONN], "%u.%u.%u.%u", &a, &b, &c, &d);
+        g_uBenchSink += (a << 24) | (b << 16) | (c << 8) | d;
+    }
+}
+
+static void bench_SocketInAddrGetText(void *pRef, int32_t iIters) {
+    char strText[16];
+    int32_t iIter;
+    for (iIter = 0; iIter < iIters; iIter++) {
+        SocketInAddrGetText(g_aAddr[iIter % BENCH_NUMCONN], strText, sizeof(strText));
+        g_uBenchSink += strText[1];
+    }
+}
+
+static void bench_InetNtop(void *pRef, int32_t iIters) {
+    char strText[16];
+    int32_t iIter;
+    for (iIter = 0; iIter < iIters; iIter++) {
+        inet_ntop(AF_INET, &g_aAddr[iIter % BENCH_NUMCONN], strText, sizeof(strText));
+        g_uBenchSink += strText[1];
+    }
+}
+
+static void bench_SnprintfAddr(void *pRef, int32_t iIters) {
+    char strText[16];
+    int32_t iIter;
+    for (iIter = 0; iIter < iIters; iIter++) {
+        uint32_t uAddr = g_aAddr[iIter % BENCH_NUMCONN];
+        snprintf(strText, sizeof(strText), "%u.%u.%u.%u", uAddr >> 24, (uAddr >> 16) & 0xff, (uAddr >> 8) & 0xff, uAddr & 0xff);
+        g_uBenchSink += strText[1];
+    }
+}
+
+static void bench_SockaddrInGetAddr(void *pRef, int32_t iIters) {
+    struct sockaddr addr;
+    int32_t iIter;
+    SockaddrInit(&addr, AF_INET);
+    SockaddrInSetAddr(&addr, 0xc0a8015a);
+    for (iIter = 0; iIter < iIters; iIter++) {
+        addr.sa_data[5] = (unsigned char)iIter;
+        g_uBenchSink += SockaddrInGetAddr(&addr);
+    }
+}
+
+static void bench_SockaddrInSetAddr(void *pRef, int32_t iIters) {
+    struct sockaddr addr;
+    int32_t iIter;
+    SockaddrInit(&addr, AF_INET);
+    for (iIter = 0; iIter < iIters; iIter++) {
+        SockaddrInSetAddr(&addr, 0xc0a80100 + iIter);
+        g_uBenchSink += addr.sa_data[5];
+    }
+}
+
+static void bench_SockaddrInPort(void *pRef, int32_t iIters) {
+    struct sockaddr addr;
+    int32_t iIter;
+    SockaddrInit(&addr, AF_INET);
+    for (iIter = 0; iIter < iIters; iIter++) {
+        SockaddrInSetPort(&addr, iIter);
+        g_uBenchSink += SockaddrInGetPort(&addr);
+    }
+}
+
+#define BENCH_MEMSLOTS (1024)
+
+//! allocation mix: mostly small strings and records, some packet buffers and fifos, rare large blocks
+static int32_t _BenchMemSize(uint32_t *pSeed) {
+    uint32_t uRand = (*pSeed = *pSeed * 1664525 + 1013904223) >> 8;
+    uint32_t uPick = uRand % 100;
+    if (uPick < 40) return 16 + uRand % 48;
+    if (uPick < 70) return 64 + uRand % 448;
+    if (uPick < 90) return 512 + uRand % 3584;
+    if (uPick < 98) return 4096 + uRand % 12288;
+    return 65536;
+}
+
+static void _BenchMemMix(void **aSlots, int32_t iIters, uint32_t bArena, uint32_t uSeed) {
+    int32_t iIter, iSlot;
+    for (iIter = 0; iIter < iIters; iIter++) {
+        iSlot = (uSeed >> 12) % BENCH_MEMSLOTS;
+        if (bArena) {
+            DirtyMemFree(aSlots[iSlot], COMMUDP_MEMID, 1, NULL);
+            aSlots[iSlot] = DirtyMemAlloc(_BenchMemSize(&uSeed), COMMUDP_MEMID, 1, NULL);
+        } else {
+            free(aSlots[iSlot]);
+            aSlots[iSlot] = malloc(_BenchMemSize(&uSeed));
+        }
+        *(uint8_t *)aSlots[iSlot] = (uint8_t)iIter;
+    }
+    for (iSlot = 0; iSlot < BENCH_MEMSLOTS; iSlot++) {
+        if (bArena) {
+            DirtyMemFree(aSlots[iSlot], COMMUDP_MEMID, 1, NULL);
+        } else {
+            free(aSlots[iSlot]);
+        }
+        aSlots[iSlot] = NULL;
+    }
+}
+
+static void bench_MemMix(int32_t iIters, uint32_t bArena) {
+    static void *aSlots[BENCH_MEMSLOTS];
+    _BenchMemMix(aSlots, iIters, bArena, 1);
+}
+
+static void bench_MemMixMalloc(void *pRef, int32_t iIters) {
+    bench_MemMix(iIters, FALSE);
+}
+
+static void bench_MemMixArena(void *pRef, int32_t iIters) {
+    bench_MemMix(iIters, TRUE);
+}
+
+static void bench_NetTick(void *pRef, int32_t iIters) {
+    int32_t iIter;
+    for (iIter = 0; iIter < iIters; iIter++) {
+        g_uBenchSink += NetTick();
+    }
+}
+
+static void bench_NetTickUsec(void *pRef, int32_t iIters) {
+    int32_t iIter;
+    for (iIter = 0; iIter < iIters; iIter++) {
+        g_uBenchSink += (uint32_t)NetTickUsec();
+    }
+}
+
+static void bench_NetTickCoarseUsec(void *pRef, int32_t iIters) {
+    int32_t iIter;
+    for (iIter = 0; iIter < iIters; iIter++) {
+        g_uBenchSink += (uint32_t)NetTickCoarseUsec();
+    }
+}
+
+#define BENCH_IDLETASKS (1024)
+
+static void _BenchIdleNop(void *pRef) {
+    g_uBenchSink += 1;
+}
+
+static void bench_NetIdleCall(void *pRef, int32_t iIters) {
+    int32_t iIter;
+    for (iIter = 0; iIter < iIters; iIter++) {
+        NetIdleCall();
+    }
+}
+
+/* NetPrintfLevel() cost: the same function with two socket traces and one CommUDP warning,
+   logged four ways. SOCKET_MEMID is capped at NETLOG_WARNING by DIRTYCODE_LOGLEVELS above,
+   so its traces compile out; COMMTCP_MEMID is not listed, so the same traces only check the
+   runtime level (NETLOG_INFO). Each variant gets its own section, and the linker's
+   __start_/__stop_ symbols for it give the code size. */
+#define BENCH_LOGFUNC(_strSection) static __attribute__((noinline, used, section(_strSection)))
+
+static volatile int32_t g_iBenchVerbose = 0;
+
+BENCH_LOGFUNC("bench_log_none") uint32_t _BenchLogNone(uint32_t uValue) {
+    uValue = uValue * 3 + 1;
+    return uValue ^ (uValue >> 7);
+}
+
+BENCH_LOGFUNC("bench_log_capped") uint32_t _BenchLogCapped(uint32_t uValue) {
+    NetPrintfLevel(SOCKET_MEMID, NETLOG_TRACE, ("socket: recv value %u\n", uValue));
+    uValue = uValue * 3 + 1;
+    NetPrintfLevel(SOCKET_MEMID, NETLOG_VERBOSE, ("socket: step value %u (%u)\n", uValue, uValue >> 7));
+    if (uValue == 0) NetPrintfLevel(COMMUDP_MEMID, NETLOG_WARNING, ("commudp: value wrapped after %u\n", uValue));
+    return uValue ^ (uValue >> 7);
+}
+
+BENCH_LOGFUNC("bench_log_runtime") uint32_t _BenchLogRuntime(uint32_t uValue) {
+    NetPrintfLevel(COMMTCP_MEMID, NETLOG_TRACE, ("socket: recv value %u\n", uValue));
+    uValue = uValue * 3 + 1;
+    NetPrintfLevel(COMMTCP_MEMID, NETLOG_VERBOSE, ("socket: step value %u (%u)\n", uValue, uValue >> 7));
+    if (uValue == 0) NetPrintfLevel(COMMUDP_MEMID, NETLOG_WARNING, ("commudp: value wrapped after %u\n", uValue));
+    return uValue ^ (uValue >> 7);
+}
+
+BENCH_LOGFUNC("bench_log_verbose") uint32_t _BenchLogVerbose(uint32_t uValue) {
+    NetPrintfVerbose((g_iBenchVerbose, 1, "socket: recv value %u\n", uValue));
+    uValue = uValue * 3 + 1;
+    NetPrintfVerbose((g_iBenchVerbose, 1, "socket: step value %u (%u)\n", uValue, uValue >> 7));
+    if (uValue == 0) NetPrintf(("commudp: value wrapped after %u\n", uValue));
+    return uValue ^ (uValue >> 7);
+}
+
+extern const uint8_t __start_bench_log_none[], __stop_bench_log_none[];
+extern const uint8_t __start_bench_log_capped[], __stop_bench_log_capped[];
+extern const uint8_t __start_bench_log_runtime[], __stop_bench_log_runtime[];
+extern const uint8_t __start_bench_log_verbose[], __stop_bench_log_verbose[];
+
+static void bench_LogNone(void *pRef, int32_t iIters) {
+    int32_t iIter;
+    for (iIter = 0; iIter < iIters; iIter++) {
+        g_uBenchSink += _BenchLogNone((uint32_t)iIter);
+    }
+}
+
+static void bench_LogCapped(void *pRef, int32_t iIters) {
+    int32_t iIter;
+    for (iIter = 0; iIter < iIters; iIter++) {
+        g_uBenchSink += _BenchLogCapped((uint32_t)iIter);
+    }
+}
+
+static void bench_LogRuntime(void *pRef, int32_t iIters) {
+    int32_t iIter;
+    for (iIter = 0; iIter < iIters; iIter++) {
+        g_uBenchSink += _BenchLogRuntime((uint32_t)iIter);
+    }
+}
+
+static void bench_LogVerbose(void *pRef, int32_t iIters) {
+    int32_t iIter;
+    for (iIter = 0; iIter < iIters; iIter++) {
+        g_uBenchSink += _BenchLogVerbose((uint32_t)iIter);
+    }
+}
+
+#define BENCH_MEMTHREADOPS (1000000)
+
+typedef struct BenchMemThreadT {
+    pthread_t thread;
+    uint32_t bArena;
+    uint32_t uSeed;
+    void *aSlots[BENCH_MEMSLOTS];
+} BenchMemThreadT;
+
+static void *_BenchMemThread(void *pArg) {
+    BenchMemThreadT *pThread = (BenchMemThreadT *)pArg;
+    _BenchMemMix(pThread->aSlots, BENCH_MEMTHREADOPS, pThread->bArena, pThread->uSeed);
+    if (pThread->bArena) {
+        DirtyMemArenaThreadFlush();
+    }
+    return NULL;
+}
+
+//! run the allocation mix on several threads at once and report aggregate throughput
+static void bench_MemThreads(const char *pName, uint32_t bArena) {
+    static BenchMemThreadT aThreads[8];
+    int32_t iNumThreads, iThread;
+    for (iNumThreads = 1; iNumThreads <= 8; iNumThreads *= 2) {
+        uint64_t uStart = _BenchNsec();
+        for (iThread = 0; iThread < iNumThreads; iThread++) {
+            aThreads[iThread].bArena = bArena;
+            aThreads[iThread].uSeed = iThread + 1;
+            pthread_create(&aThreads[iThread].thread, NULL, _BenchMemThread, &aThreads[iThread]);
+        }
+        for (iThread = 0; iThread < iNumThreads; iThread++) {
+            pthread_join(aThreads[iThread].thread, NULL);
+        }
+        printf("%-40s %d threads %8.2f Mops/s\n", pName, iNumThreads,
+            (double)BENCH_MEMTHREADOPS * iNumThreads * 1000.0 / (double)(_BenchNsec() - uStart));
+    }
+}
+
+#define BENCH_CRITTHREADS   (32)
+#define BENCH_CRITOPS       (200000)
+
+//! lock under test: the futex NetCrit, or the recursive pthread mutex it replaced
+typedef struct BenchCritT {
+    NetCritT Crit;
+    pthread_mutex_t Mutex;
+    uint32_t bPthread;
+    uint32_t aCount[16];
+} BenchCritT;
+
+static BenchCritT g_BenchCrit;
+
+static void *_BenchCritThread(void *pArg) {
+    BenchCritT *pBench = &g_BenchCrit;
+    int32_t iOp, iSlot;
+    for (iOp = 0; iOp < BENCH_CRITOPS; iOp++) {
+        if (pBench->bPthread) {
+            pthread_mutex_lock(&pBench->Mutex);
+        } else {
+            NetCritEnter(&pBench->Crit);
+        }
+        // a short section, like the CommUDP and idle list updates
+        for (iSlot = 0; iSlot < 16; iSlot++) {
+            pBench->aCount[iSlot] += iSlot;
+        }
+        if (pBench->bPthread) {
+            pthread_mutex_unlock(&pBench->Mutex);
+        } else {
+            NetCritLeave(&pBench->Crit);
+        }
+    }
+    return NULL;
+}
+
+//! run a short critical section on 1-32 threads at once and report aggregate throughput
+static void bench_CritThreads(const char *pName, uint32_t bPthread) {
+    static pthread_t aThreads[BENCH_CRITTHREADS];
+    pthread_mutexattr_t Attr;
+    int32_t iNumThreads, iThread;
+
+    pthread_mutexattr_init(&Attr);
+    pthread_mutexattr_settype(&Attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&g_BenchCrit.Mutex, &Attr);
+    pthread_mutexattr_destroy(&Attr);
+    NetCritInit(&g_BenchCrit.Crit, "bench");
+    g_BenchCrit.bPthread = bPthread;
+
+    for (iNumThreads = 1; iNumThreads <= BENCH_CRITTHREADS; iNumThreads *= 2) {
+        uint64_t uStart = _BenchNsec();
+        for (iThread = 0; iThread < iNumThreads; iThread++) {
+            pthread_create(&aThreads[iThread], NULL, _BenchCritThread, NULL);
+        }
+        for (iThread = 0; iThread < iNumThreads; iThread++) {
+            pthread_join(aThreads[iThread], NULL);
+        }
+        printf("%-40s %2d threads %8.2f Mops/s\n", pName, iNumThreads,
+            (double)BENCH_CRITOPS * iNumThreads * 1000.0 / (double)(_BenchNsec() - uStart));
+    }
+
+    NetCritKill(&g_BenchCrit.Crit);
+    pthread_mutex_destroy(&g_BenchCrit.Mutex);
+}
+
+int main(void) {
+    int32_t iTask;
+
+    _BenchInitConnStr();
+
+    BenchHeader("v5.6.2 primitives");
+    BenchRun("_CommUDPSetConnID", bench_CommUDPSetConnID, NULL);
+    BenchRun("_CommUDPParseConnStr", bench_CommUDPParseConnStr, NULL);
+    BenchRun("sscanf + _CommUDPSetConnID", bench_ConnStrSscanf, NULL);
+    BenchRun("NetHash", bench_NetHash, NULL);
+    BenchRun("NetHash x64 (per string)", bench_NetHashLoop, NULL);
+    BenchRun("NetHashBatch x64 (per string)", bench_NetHashBatch, NULL);
+    BenchRun("NetHash64 (strlen+hash)", bench_NetHash64, NULL);
+    BenchRun("SocketInTextGetAddr", bench_SocketInTextGetAddr, NULL);
+    BenchRun("inet_pton", bench_InetPton, NULL);
+    BenchRun("sscanf %u.%u.%u.%u", bench_SscanfAddr, NULL);
+    BenchRun("SocketInAddrGetText", bench_SocketInAddrGetText, NULL);
+    BenchRun("inet_ntop", bench_InetNtop, NULL);
+    BenchRun("snprintf %u.%u.%u.%u", bench_SnprintfAddr, NULL);
+    BenchRun("SockaddrInGetAddr", bench_SockaddrInGetAddr, NULL);
+    BenchRun("SockaddrInSetAddr", bench_SockaddrInSetAddr, NULL);
+    BenchRun("SockaddrInSetPort+SockaddrInGetPort", bench_SockaddrInPort, NULL);
+    BenchRun("NetTick", bench_NetTick, NULL);
+    BenchRun("NetTickUsec", bench_NetTickUsec, NULL);
+    BenchRun("NetTickCoarseUsec", bench_NetTickCoarseUsec, NULL);
+
+    printf("\nlogging, two socket traces and one commudp warning (none printed)\n");
+    printf("%-40s %4d bytes\n", "code size, no logging", (int)(__stop_bench_log_none - __start_bench_log_none));
+    printf("%-40s %4d bytes\n", "code size, NetPrintfLevel capped", (int)(__stop_bench_log_capped - __start_bench_log_capped));
+    printf("%-40s %4d bytes\n", "code size, NetPrintfLevel runtime only", (int)(__stop_bench_log_runtime - __start_bench_log_runtime));
+    printf("%-40s %4d bytes\n", "code size, NetPrintfVerbose", (int)(__stop_bench_log_verbose - __start_bench_log_verbose));
+    BenchRun("no logging", bench_LogNone, NULL);
+    BenchRun("NetPrintfLevel, capped at compile time", bench_LogCapped, NULL);
+    BenchRun("NetPrintfLevel, runtime level only", bench_LogRuntime, NULL);
+    BenchRun("NetPrintfVerbose, suppressed", bench_LogVerbose, NULL);
+    printf("\n");
+
+    DirtyMemArenaCreate(0);
+    BenchRun("malloc/free (alloc mix)", bench_MemMixMalloc, NULL);
+    BenchRun("DirtyMemAlloc/DirtyMemFree (alloc mix)", bench_MemMixArena, NULL);
+    DirtyMemDebugCreate(0);
+    BenchRun("... + live tracker", bench_MemMixArena, NULL);
+    DirtyMemDebugDestroy();
+    DirtyMemDebugCreate(64);
+    BenchRun("... + live tracker, 1/64 backtraces", bench_MemMixArena, NULL);
+    DirtyMemDebugDestroy();
+
+    NetCritInit(_NetLib_pIdleCrit, "idle");
+    for (iTask = 0; iTask < BENCH_IDLETASKS; iTask++) {
+        NetIdleAdd(_BenchIdleNop, (void *)(intptr_t)iTask);
+    }
+    BenchRun("NetIdleCall, 1024 every-call tasks", bench_NetIdleCall, NULL);
+    NetIdleReset();
+    for (iTask = 0; iTask < BENCH_IDLETASKS; iTask++) {
+        NetIdleAddInterval(_BenchIdleNop, (void *)(intptr_t)iTask, 1000 + iTask);
+    }
+    BenchRun("NetIdleCall, 1024 interval (none due)", bench_NetIdleCall, NULL);
+    NetIdleReset();
+    DirtyMemArenaDestroy();
+
+    printf("\nmulti-threaded allocation mix\n");
+    bench_MemThreads("malloc/free", FALSE);
+    DirtyMemArenaCreate(0);
+    bench_MemThreads("DirtyMemAlloc", TRUE);
+    DirtyMemArenaDestroy();
+    DirtyMemArenaCreate(DIRTYMEM_ARENA_FLAG_THREADCACHE);
+    bench_MemThreads("DirtyMemAlloc (thread cache)", TRUE);
+    DirtyMemDebugCreate(0);
+    bench_MemThreads("... + live tracker", TRUE);
+    DirtyMemDebugDestroy();
+    DirtyMemArenaDestroy();
+
+    printf("\ncontended critical section\n");
+    bench_CritThreads("pthread_mutex (recursive)", TRUE);
+    bench_CritThreads("NetCrit (futex)", FALSE);
+    return 0;
+}
@@ -0,0 +1,50 @@
+#ifndef _dirtylibstub_h
+#define _dirtylibstub_h
+
+/*
+    Builds dirtylibunix.c and stands in for the NetLibCreate() setup the tests
+    need.
+
+    With DIRTYLIBSTUB_FAKECLOCK defined to 1, dirtylibunix.c reads a clock the
+    tests set by hand (NetTickStubSet) so scheduling can be checked
+    deterministically; otherwise it reads CLOCK_MONOTONIC.
+*/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <time.h>
+
+#if DIRTYCODE_LOGGING
+// platform string formatting, used by NetPrintfVerboseCode()
+int32_t ds_vsnprintf(char *pBuffer, int32_t iLength, const char *pFormat, va_list Args) {
+    return vsnprintf(pBuffer, iLength, pFormat, Args);
+}
+#endif
+
+//! idle list critical section, normally set up by NetLibCreate()
+static NetCritT _NetLib_IdleCrit;
+NetCritT *_NetLib_pIdleCrit = &_NetLib_IdleCrit;
+
+#if DIRTYLIBSTUB_FAKECLOCK
+//! current NetTickUsec() value
+static uint64_t g_uNetTickStubUsec;
+
+static int _NetTickStubClock(clockid_t iClock, struct timespec *pNow) {
+    pNow->tv_sec = (time_t)(g_uNetTickStubUsec / 1000000);
+    pNow->tv_nsec = (long)(g_uNetTickStubUsec % 1000000) * 1000;
+    return 0;
+}
+
+// set the fake clock, in milliseconds
+static void NetTickStubSet(uint64_t uMsec) {
+    g_uNetTickStubUsec = uMsec * 1000;
+}
+
+#define clock_gettime(_iClock, _pNow) _NetTickStubClock(_iClock, _pNow)
+#include "../5.6.2/dirtylibunix.c"
+#undef clock_gettime
+#else
+#include "../5.6.2/dirtylibunix.c"
+#endif
+
+#endif // _dirtylibstub_h
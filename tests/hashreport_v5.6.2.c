@@ -0,0 +1,197 @@
+/*
+    Collision and distribution report for NetHash() and NetHash64() over connect strings.
+
+    Reads one connect string per line from the given files ("ip:port:port#$hex$hex-$hex$hex";
+    only the part after '#' is hashed, like _CommUDPSetConnID). Without arguments it
+    generates two synthetic corpora: sequential addresses in one subnet, and random
+    addresses that differ only in their trailing hex digits.
+
+    For each hash it reports exact 32-bit collisions and, for a power-of-two table with
+    one bucket per key indexed by the low bits, the longest chain, the share of empty
+    buckets (ideal ~36.8%) and the chi-square ratio (ideal ~1.0). It also reports
+    avalanche: the worst deviation from 50% of any output bit's flip rate when one input
+    bit is flipped (ideal ~0).
+
+    Build with e.g.:
+        gcc -O2 -Wno-multichar hashreport_v5.6.2.c -o hashreport -lm -lpthread && ./hashreport [corpus...]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../5.6.2/dirtylib.c"
+#include "../5.6.2/dirtymem.c"
+#include "../5.6.2/dirtymemarena.c"
+#include "dirtylibstub.h"
+
+#define HASHREPORT_SYNTHKEYS    (65536)
+#define HASHREPORT_AVALANCHE    (1000)      //!< keys sampled for the avalanche test
+#define HASHREPORT_SEED         (0x243f6a8885a308d3ull)
+
+typedef struct HashCorpusT {
+    char **pKeys;
+    int32_t iNumKeys;
+    int32_t iMaxKeys;
+} HashCorpusT;
+
+typedef uint32_t (HashFuncT)(const char *pKey, int32_t iLength);
+
+static uint32_t _HashNetHash(const char *pKey, int32_t iLength) {
+    return (uint32_t)NetHash(pKey);
+}
+
+static uint32_t _HashNetHash64(const char *pKey, int32_t iLength) {
+    return (uint32_t)NetHash64(pKey, iLength, HASHREPORT_SEED);
+}
+
+static void _CorpusAdd(HashCorpusT *pCorpus, const char *pLine) {
+    const char *pTail = strchr(pLine, '#');
+    size_t uLength;
+    pTail = (pTail != NULL) ? pTail + 1 : pLine;
+    uLength = strcspn(pTail, "\r\n");
+    if (uLength == 0) {
+        return;
+    }
+    if (pCorpus->iNumKeys == pCorpus->iMaxKeys) {
+        pCorpus->iMaxKeys = (pCorpus->iMaxKeys != 0) ? pCorpus->iMaxKeys * 2 : 1024;
+        pCorpus->pKeys = (char **)realloc(pCorpus->pKeys, pCorpus->iMaxKeys * sizeof(char *));
+    }
+    pCorpus->pKeys[pCorpus->iNumKeys] = (char *)malloc(uLength + 1);
+    memcpy(pCorpus->pKeys[pCorpus->iNumKeys], pTail, uLength);
+    pCorpus->pKeys[pCorpus->iNumKeys++][uLength] = '\0';
+}
+
+static void _CorpusFree(HashCorpusT *pCorpus) {
+    int32_t iKey;
+    for (iKey = 0; iKey < pCorpus->iNumKeys; iKey++) {
+        free(pCorpus->pKeys[iKey]);
+    }
+    free(pCorpus->pKeys);
+    memset(pCorpus, 0, sizeof(*pCorpus));
+}
+
+static int _CompareU32(const void *pA, const void *pB) {
+    uint32_t uA = *(const uint32_t *)pA, uB = *(const uint32_t *)pB;
+    return (uA > uB) - (uA < uB);
+}
+
+static void _ReportDistribution(const char *pName, HashFuncT *pHash, const HashCorpusT *pCorpus) {
+    uint32_t *pHashes = (uint32_t *)malloc(pCorpus->iNumKeys * sizeof(uint32_t));
+    uint32_t uTableSize, uBucket, uMaxChain = 0, uEmpty = 0;
+    uint32_t *pBuckets;
+    int32_t iKey, iCollisions = 0;
+    double fChiSquare = 0.0, fExpected;
+
+    for (uTableSize = 1; uTableSize < (uint32_t)pCorpus->iNumKeys; uTableSize *= 2)
+        ;
+    pBuckets = (uint32_t *)calloc(uTableSize, sizeof(uint32_t));
+    for (iKey = 0; iKey < pCorpus->iNumKeys; iKey++) {
+        pHashes[iKey] = pHash(pCorpus->pKeys[iKey], (int32_t)strlen(pCorpus->pKeys[iKey]));
+        pBuckets[pHashes[iKey] & (uTableSize - 1)] += 1;
+    }
+
+    fExpected = (double)pCorpus->iNumKeys / uTableSize;
+    for (uBucket = 0; uBucket < uTableSize; uBucket++) {
+        uMaxChain = (pBuckets[uBucket] > uMaxChain) ? pBuckets[uBucket] : uMaxChain;
+        uEmpty += (pBuckets[uBucket] == 0);
+        fChiSquare += (pBuckets[uBucket] - fExpected) * (pBuckets[uBucket] - fExpected) / fExpected;
+    }
+
+    qsort(pHashes, pCorpus->iNumKeys, sizeof(uint32_t), _CompareU32);
+    for (iKey = 1; iKey < pCorpus->iNumKeys; iKey++) {
+        iCollisions += (pHashes[iKey] == pHashes[iKey-1]);
+    }
+
+    printf("  %-10s %10d %10u %9.1f%% %10.3f", pName, iCollisions, uMaxChain,
+        100.0 * uEmpty / uTableSize, fChiSquare / (uTableSize - 1));
+    free(pBuckets);
+    free(pHashes);
+}
+
+static void _ReportAvalanche(HashFuncT *pHash, const HashCorpusT *pCorpus) {
+    static uint32_t aFlips[32];
+    double fWorst = 0.0;
+    uint32_t uTrials = 0;
+    int32_t iKey, iBit, iStep;
+    char strKey[256];
+
+    memset(aFlips, 0, sizeof(aFlips));
+    iStep = (pCorpus->iNumKeys > HASHREPORT_AVALANCHE) ? pCorpus->iNumKeys / HASHREPORT_AVALANCHE : 1;
+    for (iKey = 0; iKey < pCorpus->iNumKeys; iKey += iStep) {
+        int32_t iLength = (int32_t)strlen(pCorpus->pKeys[iKey]), iInBit;
+        uint32_t uHash;
+        if (iLength >= (int32_t)sizeof(strKey)) {
+            continue;
+        }
+        memcpy(strKey, pCorpus->pKeys[iKey], iLength + 1);
+        uHash = pHash(strKey, iLength);
+        // flip the low 7 bits of each character, keeping the key a valid string
+        for (iInBit = 0; iInBit < iLength * 7; iInBit++) {
+            uint32_t uDiff;
+            strKey[iInBit / 7] ^= (char)(1 << (iInBit % 7));
+            uDiff = uHash ^ pHash(strKey, iLength);
+            strKey[iInBit / 7] ^= (char)(1 << (iInBit % 7));
+            for (iBit = 0; iBit < 32; iBit++) {
+                aFlips[iBit] += (uDiff >> iBit) & 1;
+            }
+            uTrials += 1;
+        }
+    }
+    for (iBit = 0; iBit < 32; iBit++) {
+        double fBias = fabs((double)aFlips[iBit] / uTrials - 0.5);
+        fWorst = (fBias > fWorst) ? fBias : fWorst;
+    }
+    printf(" %9.1f%%\n", 100.0 * fWorst);
+}
+
+static void _Report(const char *pTitle, const HashCorpusT *pCorpus) {
+    printf("%s (%d keys)\n", pTitle, pCorpus->iNumKeys);
+    printf("  %-10s %10s %10s %10s %10s %10s\n", "hash", "collisions", "max chain", "empty", "chi2/df", "avalanche");
+    _ReportDistribution("NetHash", _HashNetHash, pCorpus);
+    _ReportAvalanche(_HashNetHash, pCorpus);
+    _ReportDistribution("NetHash64", _HashNetHash64, pCorpus);
+    _ReportAvalanche(_HashNetHash64, pCorpus);
+}
+
+int main(int argc, char *argv[]) {
+    HashCorpusT Corpus;
+    char strLine[512];
+    int32_t iArg, iKey;
+
+    memset(&Corpus, 0, sizeof(Corpus));
+    for (iArg = 1; iArg < argc; iArg++) {
+        FILE *pFile;
+        if ((pFile = fopen(argv[iArg], "r")) == NULL) {
+            fprintf(stderr, "unable to open %s\n", argv[iArg]);
+            return 1;
+        }
+        while (fgets(strLine, sizeof(strLine), pFile) != NULL) {
+            _CorpusAdd(&Corpus, strLine);
+        }
+        fclose(pFile);
+        _Report(argv[iArg], &Corpus);
+        _CorpusFree(&Corpus);
+    }
+    if (argc > 1) {
+        return 0;
+    }
+
+    for (iKey = 0; iKey < HASHREPORT_SYNTHKEYS; iKey++) {
+        uint32_t uAddr = 0x0a000000 + iKey, uPeer = 0x0a000000 + ((iKey + 1) % HASHREPORT_SYNTHKEYS);
+        snprintf(strLine, sizeof(strLine), "#$%08x$%08x-$%08x$%08x", uAddr, uAddr, uPeer, uPeer);
+        _CorpusAdd(&Corpus, strLine);
+    }
+    _Report("sequential addresses", &Corpus);
+    _CorpusFree(&Corpus);
+
+    srand(1);
+    for (iKey = 0; iKey < HASHREPORT_SYNTHKEYS; iKey++) {
+        uint32_t uAddr = 0xc0a80000 | (rand() & 0xffff), uPeer = 0xc0a80000 | (rand() & 0xffff);
+        snprintf(strLine, sizeof(strLine), "#$%08x$%08x-$%08x$%08x", uAddr, uAddr, uPeer, uPeer);
+        _CorpusAdd(&Corpus, strLine);
+    }
+    _Report("random addresses in one /16", &Corpus);
+    _CorpusFree(&Corpus);
+    return 0;
+}
@@ -0,0 +1,185 @@
+/*
+    Offline decoder for binary NetPrintf() output (see NetPrintfBinHook()).
+
+    Reads the concatenated records written by a binary hook from the given files, or
+    from stdin, and prints them as text. Each record is a 16-bit format id, a 16-bit
+    payload length and a 64-bit NetTickUsec() timestamp, followed by the payload.
+    Format id zero is a definition: a 16-bit id followed by the format text. The
+    other ids carry the raw arguments of a call site, rendered with
+    NetPrintfBinRender(). Format ids are never reused within a process, and a
+    definition can follow records that use it (with async output, rings are drained
+    in turn), so all definitions are read before any record is rendered.
+
+    Records are printed in timestamp order (stable, so lines from one thread keep
+    their order), prefixed by the time in seconds unless -r is given. With -d, a
+    demo stream is generated and decoded instead.
+
+    Build with e.g.:
+        gcc -O2 -Wno-multichar logdecode_v5.6.2.c -o logdecode -lpthread && ./logdecode [-r] [log...]
+*/
+
+#define DIRTYCODE_LOGGING (1)
+#define DIRTYLIBSTUB_FAKECLOCK (1)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../5.6.2/dirtylib.c"
+#include "../5.6.2/dirtymem.c"
+#include "../5.6.2/dirtymemarena.c"
+#include "dirtylibstub.h"
+
+typedef struct LogRecordT {
+    uint64_t uTime;
+    const char *pFormat;
+    const uint8_t *pArgs;
+    int32_t iArgLen;
+    int32_t iSequence;
+} LogRecordT;
+
+typedef struct LogStreamT {
+    uint8_t *pData;
+    int32_t iLength;
+    int32_t iMaxLength;
+} LogStreamT;
+
+static char *g_pFormats[65536];
+
+static int32_t _StreamWrite(void *pParm, const void *pData, int32_t iLength) {
+    LogStreamT *pStream = (LogStreamT *)pParm;
+    if (pStream->iLength + iLength > pStream->iMaxLength) {
+        pStream->iMaxLength = (pStream->iMaxLength + iLength) * 2;
+        pStream->pData = (uint8_t *)realloc(pStream->pData, pStream->iMaxLength);
+    }
+    memcpy(pStream->pData + pStream->iLength, pData, iLength);
+    pStream->iLength += iLength;
+    return 0;
+}
+
+static void _StreamRead(LogStreamT *pStream, FILE *pFile) {
+    uint8_t aBuffer[4096];
+    size_t uRead;
+    while ((uRead = fread(aBuffer, 1, sizeof(aBuffer), pFile)) > 0) {
+        _StreamWrite(pStream, aBuffer, (int32_t)uRead);
+    }
+}
+
+static int _CompareRecord(const void *pA, const void *pB) {
+    const LogRecordT *pRecA = (const LogRecordT *)pA, *pRecB = (const LogRecordT *)pB;
+    if (pRecA->uTime != pRecB->uTime) {
+        return (pRecA->uTime > pRecB->uTime) ? 1 : -1;
+    }
+    return pRecA->iSequence - pRecB->iSequence;
+}
+
+static int32_t _Decode(const LogStreamT *pStream, int32_t bRaw) {
+    LogRecordT *pRecords = (LogRecordT *)malloc((pStream->iLength / NETPRINTF_BINHEADER + 1) * sizeof(LogRecordT));
+    char strText[NETPRINTF_MAXTEXT*2];
+    int32_t iOffset, iRecord, iNumRecords = 0, iErrors = 0;
+    uint16_t uFmtId, uLength, uNewId;
+    uint64_t uTime;
+
+    // definitions first
+    for (iOffset = 0; iOffset + NETPRINTF_BINHEADER <= pStream->iLength; iOffset += NETPRINTF_BINHEADER + uLength) {
+        memcpy(&uFmtId, pStream->pData + iOffset, 2);
+        memcpy(&uLength, pStream->pData + iOffset + 2, 2);
+        if ((iOffset + NETPRINTF_BINHEADER + uLength > pStream->iLength) || (uFmtId != 0) || (uLength < 2)) {
+            continue;
+        }
+        memcpy(&uNewId, pStream->pData + iOffset + NETPRINTF_BINHEADER, 2);
+        free(g_pFormats[uNewId]);
+        g_pFormats[uNewId] = (char *)malloc(uLength - 1);
+        memcpy(g_pFormats[uNewId], pStream->pData + iOffset + NETPRINTF_BINHEADER + 2, uLength - 2);
+        g_pFormats[uNewId][uLength - 2] = '\0';
+    }
+
+    // then the records that use them
+    for (iOffset = 0; iOffset + NETPRINTF_BINHEADER <= pStream->iLength; iOffset += NETPRINTF_BINHEADER + uLength) {
+        memcpy(&uFmtId, pStream->pData + iOffset, 2);
+        memcpy(&uLength, pStream->pData + iOffset + 2, 2);
+        memcpy(&uTime, pStream->pData + iOffset + 4, 8);
+        if (iOffset + NETPRINTF_BINHEADER + uLength > pStream->iLength) {
+            break;
+        }
+        if (uFmtId == 0) {
+            iErrors += (uLength < 2) ? 1 : 0;
+            continue;
+        }
+        if (g_pFormats[uFmtId] == NULL) {
+            iErrors += 1;
+            continue;
+        }
+        pRecords[iNumRecords].uTime = uTime;
+        pRecords[iNumRecords].pFormat = g_pFormats[uFmtId];
+        pRecords[iNumRecords].pArgs = pStream->pData + iOffset + NETPRINTF_BINHEADER;
+        pRecords[iNumRecords].iArgLen = uLength;
+        pRecords[iNumRecords].iSequence = iNumRecords;
+        iNumRecords += 1;
+    }
+    if (iOffset != pStream->iLength) {
+        fprintf(stderr, "truncated record at offset %d\n", iOffset);
+        iErrors += 1;
+    }
+
+    qsort(pRecords, iNumRecords, sizeof(LogRecordT), _CompareRecord);
+    for (iRecord = 0; iRecord < iNumRecords; iRecord++) {
+        if (NetPrintfBinRender(pRecords[iRecord].pFormat, pRecords[iRecord].pArgs, pRecords[iRecord].iArgLen, strText, sizeof(strText)) < 0) {
+            iErrors += 1;
+            continue;
+        }
+        if (!bRaw) {
+            printf("%llu.%06llu ", (unsigned long long)(pRecords[iRecord].uTime / 1000000), (unsigned long long)(pRecords[iRecord].uTime % 1000000));
+        }
+        fputs(strText, stdout);
+    }
+    free(pRecords);
+    if (iErrors > 0) {
+        fprintf(stderr, "%d records could not be decoded\n", iErrors);
+    }
+    return iErrors;
+}
+
+static void _Demo(LogStreamT *pStream) {
+    static int32_t iSiteA = 0, iSiteB = 0;
+    int32_t iLine;
+    NetPrintfBinHook(_StreamWrite, pStream);
+    for (iLine = 0; iLine < 4; iLine++) {
+        NetTickStubSet(1000 + iLine * 250);
+        NetPrintfBinCode(&iSiteA, "demo: line %d of %s, ratio %.3f\n", iLine, "four", iLine / 4.0);
+        NetPrintfBinCode(&iSiteB, "demo: peer 0x%08x sent %lld bytes\n", 0xc0a80001 + iLine, 1500LL * iLine);
+    }
+    NetPrintfBinHook(NULL, NULL);
+}
+
+int main(int argc, char *argv[]) {
+    LogStreamT Stream;
+    int32_t iArg, bRaw = 0, bDemo = 0, iFiles = 0, iErrors;
+
+    memset(&Stream, 0, sizeof(Stream));
+    for (iArg = 1; iArg < argc; iArg++) {
+        FILE *pFile;
+        if (!strcmp(argv[iArg], "-r")) {
+            bRaw = 1;
+            continue;
+        }
+        if (!strcmp(argv[iArg], "-d")) {
+            bDemo = 1;
+            continue;
+        }
+        if ((pFile = fopen(argv[iArg], "rb")) == NULL) {
+            fprintf(stderr, "unable to open %s\n", argv[iArg]);
+            return 1;
+        }
+        _StreamRead(&Stream, pFile);
+        fclose(pFile);
+        iFiles += 1;
+    }
+    if (bDemo) {
+        _Demo(&Stream);
+    } else if (iFiles == 0) {
+        _StreamRead(&Stream, stdin);
+    }
+    iErrors = _Decode(&Stream, bRaw);
+    free(Stream.pData);
+    return (iErrors == 0) ? 0 : 1;
+}
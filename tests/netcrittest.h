@@ -0,0 +1,89 @@
+#ifndef _netcrittest_h
+#define _netcrittest_h
+
+/*
+    NetCrit tests shared by v5.6.2.c, which builds with DIRTYCODE_CRITSTATS, and
+    v5.6.2_netcrit.c, which builds without it like production code does.
+    Include after dirtylibstub.h.
+*/
+
+#include <assert.h>
+#include <pthread.h>
+
+#define NETCRIT_TESTTHREADS (8)
+#define NETCRIT_TESTITERS   (20000)
+
+static NetCritT g_TestCrit;
+static uint32_t g_uTestCritCount;
+
+static void *_NetCritTryThread(void *pArg) {
+    if (!NetCritTry(&g_TestCrit)) {
+        return (void *)0;
+    }
+    NetCritLeave(&g_TestCrit);
+    return (void *)1;
+}
+
+static void *_NetCritCountThread(void *pArg) {
+    int32_t i;
+    for (i = 0; i < NETCRIT_TESTITERS; i++) {
+        NetCritEnter(&g_TestCrit);
+        NetCritEnter(&g_TestCrit);
+        g_uTestCritCount += 1;
+        NetCritLeave(&g_TestCrit);
+        NetCritLeave(&g_TestCrit);
+    }
+    return NULL;
+}
+
+void test_NetCrit(void) {
+    pthread_t aThreads[NETCRIT_TESTTHREADS];
+#if defined(__linux__)
+    NetCritFutexT *pFutex;
+#endif
+    void *pResult;
+    int32_t i;
+
+    NetCritInit(&g_TestCrit, "test");
+
+    // recursive on the owning thread, unavailable to others until fully left
+    NetCritEnter(&g_TestCrit);
+    assert(NetCritTry(&g_TestCrit));
+    pthread_create(&aThreads[0], NULL, _NetCritTryThread, NULL);
+    pthread_join(aThreads[0], &pResult);
+    assert(pResult == (void *)0);
+    NetCritLeave(&g_TestCrit);
+    pthread_create(&aThreads[0], NULL, _NetCritTryThread, NULL);
+    pthread_join(aThreads[0], &pResult);
+    assert(pResult == (void *)0);
+    NetCritLeave(&g_TestCrit);
+    pthread_create(&aThreads[0], NULL, _NetCritTryThread, NULL);
+    pthread_join(aThreads[0], &pResult);
+    assert(pResult == (void *)1);
+
+    // mutual exclusion under contention
+    g_uTestCritCount = 0;
+    for (i = 0; i < NETCRIT_TESTTHREADS; i++) {
+        pthread_create(&aThreads[i], NULL, _NetCritCountThread, NULL);
+    }
+    for (i = 0; i < NETCRIT_TESTTHREADS; i++) {
+        pthread_join(aThreads[i], NULL);
+    }
+    assert(g_uTestCritCount == NETCRIT_TESTTHREADS * NETCRIT_TESTITERS);
+    assert(NetCritTry(&g_TestCrit));
+    NetCritLeave(&g_TestCrit);
+#if defined(__linux__)
+    // the spin limit follows the average: it decays to the minimum once acquisitions stop spinning
+    pFutex = (NetCritFutexT *)g_TestCrit.data;
+    pFutex->iSpin = 8 * 50;
+    for (i = 0; i < 64; i++) {
+        _NetCritWait(pFutex);
+        assert(pFutex->iState == NETCRIT_LOCKED);
+        __atomic_store_n(&pFutex->iState, NETCRIT_UNLOCKED, __ATOMIC_RELEASE);
+    }
+    assert(pFutex->iSpin < 8);
+#endif
+    NetCritKill(&g_TestCrit);
+}
+
+#endif // _netcrittest_h
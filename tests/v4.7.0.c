@@ -15,10 +15,84 @@ void test_CommUDPSetConnID(void) {
     assert(ref.connident == 0x08F43358);
 }
 
+void test_CommUDPParseConnStr(void) {
+    const char *aStrings[] = {
+        "192.168.1.90:3659:3659#$c0a8015a$c0a8015a-$c0a8015a$c0a8015a",
+        "10.0.0.1:1#$0A000001$0a000002$0a000003$0a000004$0a000005",
+        "host.example.com:3659#$c0a8015a",
+        "300.1.1.1:3659:3659#$zz$c0a8015a",
+        "1.2.3.4:99999#-$01020304",
+        "#",
+        "12#$c0a8015a$c0a8015a-$c0a8015a$c0a8015a",
+        "1.2#$c0a8015a",
+        "1.2.3.4#$c0a8015ab$0a000001",
+        "0255.1.2.3:3659#$c0a8015a",
+        "01.2.3.4#$c0a8015a",
+        "1.2.3.0255#$c0a8015a",
+        "1.2.3.4#$c0a8015a-$0a000001-$0a000002",
+    };
+    CommUDPConnStrT ConnStr;
+    CommUDPRef ref;
+    uint32_t uFields;
+    int32_t i;
+
+    uFields = _CommUDPParseConnStr(aStrings[0], &ConnStr);
+    assert(uFields == (COMMUDP_CONNSTR_ADDR|COMMUDP_CONNSTR_PORT|COMMUDP_CONNSTR_PORT2|COMMUDP_CONNSTR_CONNID));
+    assert((ConnStr.uAddr == 0xc0a8015a) && (ConnStr.iPort == 3659) && (ConnStr.iPort2 == 3659));
+    assert(ConnStr.uConnIdent == 0x08F43358);
+    assert((ConnStr.iNumAddr == 4) && (ConnStr.iNumAddrLocal == 2) && (ConnStr.aAddr[3] == 0xc0a8015a));
+    assert(ConnStr.pConnID == strchr(aStrings[0], '#'));
+
+    uFields = _CommUDPParseConnStr(aStrings[1], &ConnStr);
+    assert(uFields == (COMMUDP_CONNSTR_ADDR|COMMUDP_CONNSTR_PORT|COMMUDP_CONNSTR_CONNID));
+    assert((ConnStr.iNumAddr == COMMUDP_CONNSTR_MAXADDR) && (ConnStr.aAddr[0] == 0x0a000001) && (ConnStr.aAddr[3] == 0x0a000004));
+    assert(ConnStr.iNumAddrLocal == -1);
+
+    assert(_CommUDPParseConnStr(aStrings[2], &ConnStr) == COMMUDP_CONNSTR_CONNID);
+    assert(_CommUDPParseConnStr(aStrings[3], &ConnStr) == COMMUDP_CONNSTR_CONNID);
+    assert((ConnStr.iNumAddr == 1) && (ConnStr.aAddr[0] == 0xc0a8015a));
+    assert(_CommUDPParseConnStr(aStrings[4], &ConnStr) == (COMMUDP_CONNSTR_ADDR|COMMUDP_CONNSTR_CONNID));
+    assert((ConnStr.iNumAddr == 1) && (ConnStr.iNumAddrLocal == 0));
+    assert(_CommUDPParseConnStr("192.168.1.90:3659", &ConnStr) == (COMMUDP_CONNSTR_ADDR|COMMUDP_CONNSTR_PORT));
+    assert(ConnStr.pConnID == NULL);
+
+    // a digit run ending at the '#' must not consume it
+    assert(_CommUDPParseConnStr(aStrings[6], &ConnStr) == COMMUDP_CONNSTR_CONNID);
+    assert((ConnStr.pConnID == strchr(aStrings[6], '#')) && (ConnStr.iNumAddr == 4) && (ConnStr.iNumAddrLocal == 2));
+    assert(_CommUDPParseConnStr(aStrings[7], &ConnStr) == COMMUDP_CONNSTR_CONNID);
+    assert((ConnStr.pConnID == strchr(aStrings[7], '#')) && (ConnStr.iNumAddr == 1));
+
+    // nine hex digits are not an address
+    assert(_CommUDPParseConnStr(aStrings[8], &ConnStr) == (COMMUDP_CONNSTR_ADDR|COMMUDP_CONNSTR_CONNID));
+    assert((ConnStr.iNumAddr == 1) && (ConnStr.aAddr[0] == 0x0a000001));
+
+    // octets are one to three digits with no leading zero
+    assert(_CommUDPParseConnStr(aStrings[9], &ConnStr) == COMMUDP_CONNSTR_CONNID);
+    assert((ConnStr.iNumAddr == 1) && (ConnStr.aAddr[0] == 0xc0a8015a));
+    assert(_CommUDPParseConnStr(aStrings[10], &ConnStr) == COMMUDP_CONNSTR_CONNID);
+    assert(_CommUDPParseConnStr(aStrings[11], &ConnStr) == COMMUDP_CONNSTR_CONNID);
+    assert((ConnStr.iNumAddr == 1) && (ConnStr.iNumAddrLocal == -1));
+
+    // a leading '-' means no local candidates, and only the first '-' counts
+    assert(_CommUDPParseConnStr(aStrings[4], &ConnStr) == (COMMUDP_CONNSTR_ADDR|COMMUDP_CONNSTR_CONNID));
+    assert(ConnStr.iNumAddrLocal == 0);
+    assert(_CommUDPParseConnStr(aStrings[12], &ConnStr) == (COMMUDP_CONNSTR_ADDR|COMMUDP_CONNSTR_CONNID));
+    assert((ConnStr.iNumAddr == 3) && (ConnStr.iNumAddrLocal == 1));
+
+    // the connident always matches _CommUDPSetConnID
+    for (i = 0; i < (int32_t)(sizeof(aStrings)/sizeof(aStrings[0])); i++) {
+        memset(&ref, 0, sizeof(ref));
+        _CommUDPSetConnID(&ref, aStrings[i]);
+        _CommUDPParseConnStr(aStrings[i], &ConnStr);
+        assert(ConnStr.uConnIdent == ref.connident);
+    }
+}
+
 int main(void) {
     printf("Running tests...\n");
     
     test_CommUDPSetConnID();
+    test_CommUDPParseConnStr();
     
     printf("All tests passed!\n");
     return 0;
@@ -1,8 +1,25 @@
+// library tests; the memids are four-character constants, so build with: gcc -Wno-multichar v5.6.2.c -lpthread
+#define DIRTYCODE_LOGGING (1)
+#define DIRTYCODE_MEMTRACK (1)
+#define DIRTYLIBSTUB_FAKECLOCK (1)
+#define DIRTYCODE_CRITSTATS (1)
+#define DIRTYCODE_LOGLEVELS NETLOG_THRESHOLD(COMMUDP_MEMID, NETLOG_WARNING) NETLOG_THRESHOLD(PROTOHTTP_MEMID, NETLOG_ERROR)
+
 #include <assert.h>
 #include <stdio.h>
 #include <string.h>
+#include <wchar.h>
 #include "../5.6.2/commudp.c"
 #include "../5.6.2/dirtylib.c"
+#include "../5.6.2/dirtymem.c"
+#include "../5.6.2/dirtynet.c"
+#include "../5.6.2/dirtymemarena.c"
+#include "dirtylibstub.h"
+#include "netcrittest.h"
+
+// libc reference conversions; declared here since dirtynet.h has its own sockaddr definitions
+int inet_pton(int af, const char *src, void *dst);
+const char *inet_ntop(int af, const void *src, char *dst, unsigned int size);
 
 void test_CommUDPSetConnID(void) {
     CommUDPRef ref;
@@ -16,16 +33,962 @@ void test_CommUDPSetConnID(void) {
     assert(ref.connident == 0xC6627546);
 }
 
+void test_CommUDPParseConnStr(void) {
+    const char *aStrings[] = {
+        "192.168.1.90:3659:3659#$c0a8015a$c0a8015a-$c0a8015a$c0a8015a",
+        "10.0.0.1:1#$0A000001$0a000002$0a000003$0a000004$0a000005",
+        "host.example.com:3659#$c0a8015a",
+        "300.1.1.1:3659:3659#$zz$c0a8015a",
+        "1.2.3.4:99999#-$01020304",
+        "#",
+        "12#$c0a8015a$c0a8015a-$c0a8015a$c0a8015a",
+        "1.2#$c0a8015a",
+        "1.2.3.4#$c0a8015ab$0a000001",
+        "0255.1.2.3:3659#$c0a8015a",
+        "01.2.3.4#$c0a8015a",
+        "1.2.3.0255#$c0a8015a",
+        "1.2.3.4#$c0a8015a-$0a000001-$0a000002",
+    };
+    CommUDPConnStrT ConnStr;
+    CommUDPRef ref;
+    uint32_t uFields;
+    int32_t i;
+
+    uFields = _CommUDPParseConnStr(aStrings[0], &ConnStr);
+    assert(uFields == (COMMUDP_CONNSTR_ADDR|COMMUDP_CONNSTR_PORT|COMMUDP_CONNSTR_PORT2|COMMUDP_CONNSTR_CONNID));
+    assert((ConnStr.uAddr == 0xc0a8015a) && (ConnStr.iPort == 3659) && (ConnStr.iPort2 == 3659));
+    assert(ConnStr.uConnIdent == 0xC6627546);
+    assert((ConnStr.iNumAddr == 4) && (ConnStr.iNumAddrLocal == 2) && (ConnStr.aAddr[3] == 0xc0a8015a));
+    assert(ConnStr.pConnID == strchr(aStrings[0], '#'));
+
+    uFields = _CommUDPParseConnStr(aStrings[1], &ConnStr);
+    assert(uFields == (COMMUDP_CONNSTR_ADDR|COMMUDP_CONNSTR_PORT|COMMUDP_CONNSTR_CONNID));
+    assert((ConnStr.iNumAddr == COMMUDP_CONNSTR_MAXADDR) && (ConnStr.aAddr[0] == 0x0a000001) && (ConnStr.aAddr[3] == 0x0a000004));
+    assert(ConnStr.iNumAddrLocal == -1);
+
+    assert(_CommUDPParseConnStr(aStrings[2], &ConnStr) == COMMUDP_CONNSTR_CONNID);
+    assert(_CommUDPParseConnStr(aStrings[3], &ConnStr) == COMMUDP_CONNSTR_CONNID);
+    assert((ConnStr.iNumAddr == 1) && (ConnStr.aAddr[0] == 0xc0a8015a));
+    assert(_CommUDPParseConnStr(aStrings[4], &ConnStr) == (COMMUDP_CONNSTR_ADDR|COMMUDP_CONNSTR_CONNID));
+    assert((ConnStr.iNumAddr == 1) && (ConnStr.iNumAddrLocal == 0));
+    assert(_CommUDPParseConnStr("192.168.1.90:3659", &ConnStr) == (COMMUDP_CONNSTR_ADDR|COMMUDP_CONNSTR_PORT));
+    assert(ConnStr.pConnID == NULL);
+
+    // a digit run ending at the '#' must not consume it
+    assert(_CommUDPParseConnStr(aStrings[6], &ConnStr) == COMMUDP_CONNSTR_CONNID);
+    assert((ConnStr.pConnID == strchr(aStrings[6], '#')) && (ConnStr.iNumAddr == 4) && (ConnStr.iNumAddrLocal == 2));
+    assert(_CommUDPParseConnStr(aStrings[7], &ConnStr) == COMMUDP_CONNSTR_CONNID);
+    assert((ConnStr.pConnID == strchr(aStrings[7], '#')) && (ConnStr.iNumAddr == 1));
+
+    // nine hex digits are not an address
+    assert(_CommUDPParseConnStr(aStrings[8], &ConnStr) == (COMMUDP_CONNSTR_ADDR|COMMUDP_CONNSTR_CONNID));
+    assert((ConnStr.iNumAddr == 1) && (ConnStr.aAddr[0] == 0x0a000001));
+
+    // octets are one to three digits with no leading zero
+    assert(_CommUDPParseConnStr(aStrings[9], &ConnStr) == COMMUDP_CONNSTR_CONNID);
+    assert((ConnStr.iNumAddr == 1) && (ConnStr.aAddr[0] == 0xc0a8015a));
+    assert(_CommUDPParseConnStr(aStrings[10], &ConnStr) == COMMUDP_CONNSTR_CONNID);
+    assert(_CommUDPParseConnStr(aStrings[11], &ConnStr) == COMMUDP_CONNSTR_CONNID);
+    assert((ConnStr.iNumAddr == 1) && (ConnStr.iNumAddrLocal == -1));
+
+    // a leading '-' means no local candidates, and only the first '-' counts
+    assert(_CommUDPParseConnStr(aStrings[4], &ConnStr) == (COMMUDP_CONNSTR_ADDR|COMMUDP_CONNSTR_CONNID));
+    assert(ConnStr.iNumAddrLocal == 0);
+    assert(_CommUDPParseConnStr(aStrings[12], &ConnStr) == (COMMUDP_CONNSTR_ADDR|COMMUDP_CONNSTR_CONNID));
+    assert((ConnStr.iNumAddr == 3) && (ConnStr.iNumAddrLocal == 1));
+
+    // the connident always matches _CommUDPSetConnID
+    for (i = 0; i < (int32_t)(sizeof(aStrings)/sizeof(aStrings[0])); i++) {
+        memset(&ref, 0, sizeof(ref));
+        _CommUDPSetConnID(&ref, aStrings[i]);
+        _CommUDPParseConnStr(aStrings[i], &ConnStr);
+        assert(ConnStr.uConnIdent == ref.connident);
+    }
+}
+
 void test_NetHash(void) {
     uint32_t hash = NetHash("$c0a8015a$c0a8015a-$c0a8015a$c0a8015a");
     assert(hash == 0xC6627546);
 }
 
+// 4.7.0 _CommUDPSetConnID inline hash loop
+static uint32_t _NetHash470(const char *pString) {
+    uint32_t uHash = 0;
+    for (const char *pChar = pString; *pChar != '\0'; pChar++) {
+        uHash = (int)*pChar ^ (int)uHash >> 0x1b ^ uHash << 5;
+    }
+    return uHash;
+}
+
+void test_NetHashBatch(void) {
+    const char *aStrings[67];
+    char aBuffers[64][80];
+    int32_t aHashes[67], i;
+
+    // connect strings of varying length, with and without the '#', plus high-bit bytes
+    for (i = 0; i < 64; i++) {
+        snprintf(aBuffers[i], sizeof(aBuffers[i]), "%s$%08x$%08x-$%08x", (i & 1) ? "#" : "", 0xc0a80100 + i*i, i, 0xfffffff0 - i);
+        if (i % 7 == 0) {
+            aBuffers[i][i % 20] = (char)(0x80 + i);
+        }
+        aStrings[i] = aBuffers[i] + (i % 5);
+    }
+    aStrings[64] = "";
+    aStrings[65] = "$c0a8015a$c0a8015a-$c0a8015a$c0a8015a";
+    aStrings[66] = "#$c0a8015a$c0a8015a-$c0a8015a$c0a8015a";
+
+    // every batch size, so lanes run empty and refill at every offset
+    for (i = 0; i <= 67; i++) {
+        int32_t j;
+        memset(aHashes, 0xcc, sizeof(aHashes));
+        NetHashBatch(aStrings + 67 - i, aHashes, i);
+        for (j = 0; j < i; j++) {
+            assert(aHashes[j] == NetHash(aStrings[67 - i + j]));
+            assert((uint32_t)aHashes[j] == _NetHash470(aStrings[67 - i + j]));
+        }
+    }
+    NetHashBatch(aStrings, aHashes, 67);
+    assert(aHashes[64] == 0);
+    assert((uint32_t)aHashes[65] == 0xC6627546);
+    assert((uint32_t)aHashes[66] == 0x08F43358);
+}
+
+void test_NetHash64(void) {
+    uint8_t aData[200], aCopy[208];
+    uint64_t aHashes[201];
+    int32_t i, j;
+
+    for (i = 0; i < (int32_t)sizeof(aData); i++) {
+        aData[i] = (uint8_t)(i * 37 + 11);
+    }
+
+    // every length hashes differently, and the same bytes hash the same at any alignment
+    for (i = 0; i <= 200; i++) {
+        aHashes[i] = NetHash64(aData, i, 1);
+        for (j = 1; j < 8; j++) {
+            memcpy(aCopy + j, aData, i);
+            assert(NetHash64(aCopy + j, i, 1) == aHashes[i]);
+        }
+        for (j = 0; j < i; j++) {
+            assert(aHashes[j] != aHashes[i]);
+        }
+    }
+
+    // the seed and every input bit change the result
+    assert(NetHash64(aData, 40, 1) != NetHash64(aData, 40, 2));
+    for (i = 0; i < 60*8; i++) {
+        aData[i/8] ^= (uint8_t)(1 << (i%8));
+        assert(NetHash64(aData, 60, 1) != aHashes[60]);
+        aData[i/8] ^= (uint8_t)(1 << (i%8));
+    }
+    assert(NetHash64(aData, 60, 1) == aHashes[60]);
+}
+
+static void _CheckAddrText(uint32_t uAddr) {
+    char strText[16], strRef[16];
+    uint8_t aRef[4];
+    struct sockaddr addr;
+
+    SocketInAddrGetText(uAddr, strText, sizeof(strText));
+    aRef[0] = (uint8_t)(uAddr >> 24); aRef[1] = (uint8_t)(uAddr >> 16); aRef[2] = (uint8_t)(uAddr >> 8); aRef[3] = (uint8_t)uAddr;
+    inet_ntop(AF_INET, aRef, strRef, sizeof(strRef));
+    assert(strcmp(strText, strRef) == 0);
+    assert((uint32_t)SocketInTextGetAddr(strRef) == uAddr);
+
+    SockaddrInit(&addr, AF_INET);
+    assert(SockaddrInSetAddrText(&addr, strRef) == 0);
+    assert(SockaddrInGetAddr(&addr) == uAddr);
+}
+
+void test_SocketInAddrText(void) {
+    const char *aBad[] = { "", "1", "1.2.3", "1.2.3.4.", "1.2.3.256", "1.2.3.1000", "1..3.4", ".1.2.3",
+        "1.2.3.4 ", "a.b.c.d", "$c0a8015", "$c0a8015g", "$c0a8015a0", "1.2.3.-4", "01.2.3.4", "1.2.3.00", "1.2.003.4" };
+    char strText[16], strSmall[8];
+    struct sockaddr addr;
+    uint8_t aRef[4];
+    uint32_t uAddr;
+    int32_t i;
+
+    /* every value in every octet position, then a sampled (not exhaustive) stride through
+       the whole space; formatting handles each octet independently, so the first loop
+       covers every octet string the formatter can produce */
+    for (i = 0; i < 256; i++) {
+        _CheckAddrText((uint32_t)i);
+        _CheckAddrText((uint32_t)i << 8);
+        _CheckAddrText((uint32_t)i << 16);
+        _CheckAddrText((uint32_t)i << 24);
+        _CheckAddrText(0x01010101u * i);
+    }
+    for (uAddr = 0; uAddr < 0xfffff000u; uAddr += 4093) {
+        _CheckAddrText(uAddr);
+    }
+    _CheckAddrText(0xffffffff);
+
+    // malformed text is rejected exactly when inet_pton rejects it
+    SockaddrInit(&addr, AF_INET);
+    SockaddrInSetAddr(&addr, 0x01020304);
+    for (i = 0; i < (int32_t)(sizeof(aBad)/sizeof(aBad[0])); i++) {
+        assert(SocketInTextGetAddr(aBad[i]) == 0);
+        assert(SockaddrInSetAddrText(&addr, aBad[i]) < 0);
+        assert((aBad[i][0] == '$') || (inet_pton(AF_INET, aBad[i], aRef) == 0));
+    }
+    assert(SockaddrInGetAddr(&addr) == 0x01020304);
+
+    // $hex form and truncation
+    assert((uint32_t)SocketInTextGetAddr("$c0a8015a") == 0xc0a8015a);
+    assert((uint32_t)SocketInTextGetAddr("$C0A8015A") == 0xc0a8015a);
+    assert(strcmp(SocketInAddrGetText(0xc0a8015a, strSmall, sizeof(strSmall)), "192.168") == 0);
+    assert(strcmp(SockaddrInGetAddrText(&addr, strText, sizeof(strText)), "1.2.3.4") == 0);
+}
+
+static int32_t g_aIdleCount[100];
+static int32_t g_aIdleLog[16], g_iIdleLog;
+
+static void _IdleCount(void *pRef) {
+    g_aIdleCount[(int32_t *)pRef - g_aIdleCount] += 1;
+}
+
+static void _IdleSelfDel(void *pRef) {
+    *(int32_t *)pRef += 1;
+    NetIdleDel(_IdleSelfDel, pRef);
+    // adding from a callback may grow the storage
+    NetIdleAdd(_IdleCount, &g_aIdleCount[99]);
+}
+
+static void _IdleLog(void *pRef) {
+    g_aIdleLog[g_iIdleLog++ % 16] = (int32_t)(intptr_t)pRef;
+}
+
+static void *_NetTickCoarseThread(void *pArg) {
+    *(uint64_t *)pArg = NetTickCoarseUsec();
+    return(NULL);
+}
+
+void test_NetTick(void) {
+    pthread_t thread;
+    uint64_t uCoarse;
+
+    // all three clocks derive from the same microsecond reading
+    g_uNetTickStubUsec = 1234567;
+    assert(NetTickUsec() == 1234567);
+    assert(NetTick64() == 1234);
+    assert(NetTick() == 1234);
+
+    // the coarse tick only moves on update
+    assert(NetTickUpdate() == 1234567);
+    g_uNetTickStubUsec = 2000000;
+    assert(NetTickCoarseUsec() == 1234567);
+    assert(NetTickUpdate() == 2000000);
+    assert(NetTickCoarseUsec() == 2000000);
+
+    // NetTick wraps after ~49.7 days, NetTick64 does not
+    NetTickStubSet(0x100000005ull);
+    assert(NetTick64() == 0x100000005ull);
+    assert(NetTick() == 5);
+    assert(NetTickDiff(NetTick(), 0xfffffffb) == 10);
+
+    // an idle pass refreshes the coarse tick for every thread
+    NetCritInit(_NetLib_pIdleCrit, "idle");
+    NetIdleCall();
+    assert(NetTickCoarseUsec() == 0x100000005ull * 1000);
+    pthread_create(&thread, NULL, _NetTickCoarseThread, &uCoarse);
+    pthread_join(thread, NULL);
+    assert(uCoarse == 0x100000005ull * 1000);
+    NetCritKill(_NetLib_pIdleCrit);
+
+    // it never goes backwards; reset it for the tests that rewind the fake clock
+    g_uNetTickStubUsec = 1000;
+    assert(NetTickUpdate() == 0x100000005ull * 1000);
+    _NetLib_uCoarseUsec = 0;
+}
+
+void test_NetCritStat(void) {
+    NetCritStatT stat;
+    pthread_t thread;
+    void *pResult;
+    char strReport[1024];
+    NetCritT crit;
+    int32_t i;
+
+    NetCritStatControl(1);
+    NetCritInit(&g_TestCrit, "stattest");
+
+    // a 5us hold, with a nested enter that is not counted again
+    NetCritEnter(&g_TestCrit);
+    NetCritEnter(&g_TestCrit);
+    g_uNetTickStubUsec += 5;
+    NetCritLeave(&g_TestCrit);
+    pthread_create(&thread, NULL, _NetCritTryThread, NULL);
+    pthread_join(thread, &pResult);
+    assert(pResult == (void *)0);
+    NetCritLeave(&g_TestCrit);
+
+    // an untimed acquisition by try
+    NetCritStatControl(0);
+    assert(NetCritTry(&g_TestCrit));
+    g_uNetTickStubUsec += 100;
+    NetCritLeave(&g_TestCrit);
+
+    assert(NetCritStatGet("stattest", &stat) == 0);
+    assert((stat.uAcquires == 2) && (stat.uContended == 0) && (stat.uTryFails == 1) && (stat.uSampled == 1));
+    assert(stat.aHoldHist[3] == 1);
+    assert((stat.uMaxHoldNs == 5000) && (stat.iMaxHoldThread == _NetCritThreadId()) && (stat.pMaxHoldCaller != NULL));
+
+    assert(NetCritStatReport(strReport, sizeof(strReport)) < (int32_t)sizeof(strReport));
+    assert(strstr(strReport, "'stattest' acquires 2 contended 0 (0.0%) try fails 1 sampled 1 longest hold 5000 ns") != NULL);
+    assert(strstr(strReport, "    hold 0 0 0 1 0 0 0 0\n") != NULL);
+
+    // initializing again without a kill keeps the slot and resets it
+    for (i = 0; i < 100; i++) {
+        NetCritInit(&g_TestCrit, "stattest");
+    }
+    assert(NetCritStatGet("stattest", &stat) == 0);
+    assert(stat.uAcquires == 0);
+    NetCritInit(&crit, "stattest2");
+    assert(NetCritStatGet("stattest2", &stat) == 0);
+    NetCritKill(&crit);
+
+    // killing a section frees its slot
+    NetCritKill(&g_TestCrit);
+    assert(NetCritStatGet("stattest", &stat) < 0);
+}
+
+#define NETPRINTF_TESTTHREADS   (4)
+#define NETPRINTF_TESTLINES     (200)
+#define NETPRINTF_TESTFLOOD     (2000)
+
+static pthread_mutex_t g_PrintfLock = PTHREAD_MUTEX_INITIALIZER;
+static char g_strPrintf[64*1024];
+static int32_t g_iPrintfLen, g_iPrintfLines;
+static volatile int32_t g_bPrintfBlock, g_bPrintfBlocked;
+
+static int32_t _NetPrintfTestHook(void *pParm, const char *pText) {
+    int32_t iLength = (int32_t)strlen(pText);
+    pthread_mutex_lock(&g_PrintfLock);
+    if ((g_iPrintfLen + iLength) < (int32_t)sizeof(g_strPrintf)) {
+        memcpy(g_strPrintf + g_iPrintfLen, pText, iLength + 1);
+        g_iPrintfLen += iLength;
+    }
+    g_iPrintfLines += 1;
+    pthread_mutex_unlock(&g_PrintfLock);
+    // optionally stall the sink, as a slow log target would
+    while (__atomic_load_n(&g_bPrintfBlock, __ATOMIC_ACQUIRE)) {
+        __atomic_store_n(&g_bPrintfBlocked, 1, __ATOMIC_RELEASE);
+    }
+    return 0;
+}
+
+static void _NetPrintfTestReset(void) {
+    g_strPrintf[0] = '\0';
+    g_iPrintfLen = g_iPrintfLines = 0;
+}
+
+//! total the drop reports in the captured output; the drain may report a run of drops in pieces
+static uint32_t _NetPrintfTestDropped(int32_t *pReports) {
+    const char *pLine;
+    uint32_t uDropped, uTotal = 0;
+    for (pLine = g_strPrintf, *pReports = 0; (pLine = strstr(pLine, "dirtylib: dropped ")) != NULL; pLine += 1) {
+        assert(sscanf(pLine, "dirtylib: dropped %u lines", &uDropped) == 1);
+        uTotal += uDropped;
+        *pReports += 1;
+    }
+    return uTotal;
+}
+
+static void *_NetPrintfTestThread(void *pArg) {
+    int32_t i;
+    for (i = 0; i < NETPRINTF_TESTLINES; i++) {
+        NetPrintf(("t%d %d\n", (int32_t)(intptr_t)pArg, i));
+    }
+    return NULL;
+}
+
+static pthread_barrier_t g_PrintfRingBarrier;
+
+//! log one line, then keep the ring until every thread has logged
+static void *_NetPrintfRingThread(void *pArg) {
+    NetPrintf(("r%d\n", (int32_t)(intptr_t)pArg));
+    pthread_barrier_wait(&g_PrintfRingBarrier);
+    return NULL;
+}
+
+void test_NetPrintf(void) {
+    pthread_t aThreads[NETPRINTF_TESTTHREADS], aRingThreads[NETPRINTF_RINGS + 4];
+    char strLine[32];
+    const char *pLine;
+    int32_t i, iNext[NETPRINTF_TESTTHREADS], iThread, iValue, iReports;
+    uint32_t uDropped = 0;
+
+    NetPrintfHook(_NetPrintfTestHook, NULL);
+
+    // suppressed verbose lines are not written
+    _NetPrintfTestReset();
+    NetPrintfVerbose((0, 0, "hidden %d\n", 1));
+    NetPrintfVerbose((1, 0, "shown %d\n", 2));
+    assert(!strcmp(g_strPrintf, "shown 2\n"));
+
+    // async: every line arrives, in order per thread
+    _NetPrintfTestReset();
+    assert(NetPrintfAsyncStart() == 0);
+    for (i = 0; i < NETPRINTF_TESTTHREADS; i++) {
+        pthread_create(&aThreads[i], NULL, _NetPrintfTestThread, (void *)(intptr_t)i);
+    }
+    for (i = 0; i < NETPRINTF_TESTTHREADS; i++) {
+        pthread_join(aThreads[i], NULL);
+    }
+    NetPrintfAsyncStop();
+    assert(g_iPrintfLines == NETPRINTF_TESTTHREADS * NETPRINTF_TESTLINES);
+    memset(iNext, 0, sizeof(iNext));
+    for (pLine = g_strPrintf; sscanf(pLine, "t%d %d\n", &iThread, &iValue) == 2; pLine = strchr(pLine, '\n') + 1) {
+        assert(iValue == iNext[iThread]++);
+    }
+    for (i = 0; i < NETPRINTF_TESTTHREADS; i++) {
+        assert(iNext[i] == NETPRINTF_TESTLINES);
+    }
+
+    // a stalled sink makes a full ring drop lines instead of blocking the caller
+    _NetPrintfTestReset();
+    assert(NetPrintfAsyncStart() == 0);
+    __atomic_store_n(&g_bPrintfBlock, 1, __ATOMIC_RELEASE);
+    NetPrintf(("first\n"));
+    while (!__atomic_load_n(&g_bPrintfBlocked, __ATOMIC_ACQUIRE))
+        ;
+    for (i = 0; i < NETPRINTF_TESTFLOOD; i++) {
+        NetPrintf(("flood %d\n", i));
+    }
+    __atomic_store_n(&g_bPrintfBlock, 0, __ATOMIC_RELEASE);
+    NetPrintfAsyncStop();
+    uDropped = _NetPrintfTestDropped(&iReports);
+    assert((uDropped > 0) && ((g_iPrintfLines - iReports) + uDropped == NETPRINTF_TESTFLOOD + 1));
+
+    // threads beyond the rings drop their lines rather than writing them synchronously
+    _NetPrintfTestReset();
+    assert(NetPrintfAsyncStart() == 0);
+    pthread_barrier_init(&g_PrintfRingBarrier, NULL, NETPRINTF_RINGS + 4);
+    for (i = 0; i < NETPRINTF_RINGS + 4; i++) {
+        pthread_create(&aRingThreads[i], NULL, _NetPrintfRingThread, (void *)(intptr_t)i);
+    }
+    for (i = 0; i < NETPRINTF_RINGS + 4; i++) {
+        pthread_join(aRingThreads[i], NULL);
+    }
+    pthread_barrier_destroy(&g_PrintfRingBarrier);
+    NetPrintfAsyncStop();
+    assert(strstr(g_strPrintf, " lines of debug output from threads without a ring\n") != NULL);
+    uDropped = _NetPrintfTestDropped(&iReports);
+    assert((uDropped >= 4) && ((g_iPrintfLines - iReports) + uDropped == NETPRINTF_RINGS + 4));
+
+    // synchronous again after stop
+    _NetPrintfTestReset();
+    snprintf(strLine, sizeof(strLine), "sync %d\n", 3);
+    NetPrintf(("sync %d\n", 3));
+    assert(!strcmp(g_strPrintf, strLine));
+    NetPrintfHook(NULL, NULL);
+}
+
+void test_NetPrintfLevel(void) {
+    int32_t iCount = 0;
+
+    NetPrintfHook(_NetPrintfTestHook, NULL);
+    _NetPrintfTestReset();
+    NetLogSetLevel(NETLOG_INFO);
+
+    // above the compile-time threshold: arguments are not even evaluated
+    NetPrintfLevel(COMMUDP_MEMID, NETLOG_INFO, ("cudp info %d\n", ++iCount));
+    NetPrintfLevel(PROTOHTTP_MEMID, NETLOG_WARNING, ("http warning %d\n", ++iCount));
+    assert((iCount == 0) && (g_iPrintfLines == 0));
+
+    // at or below it, subject to the runtime level
+    NetPrintfLevel(COMMUDP_MEMID, NETLOG_WARNING, ("cudp warning\n"));
+    NetPrintfLevel(PROTOHTTP_MEMID, NETLOG_ERROR, ("http error\n"));
+    NetPrintfLevel(VOIP_MEMID, NETLOG_VERBOSE, ("voip verbose %d\n", ++iCount));
+    assert((iCount == 0) && !strcmp(g_strPrintf, "cudp warning\nhttp error\n"));
+    NetLogSetLevel(NETLOG_TRACE);
+    NetPrintfLevel(VOIP_MEMID, NETLOG_VERBOSE, ("voip verbose %d\n", ++iCount));
+    NetPrintfLevel(COMMUDP_MEMID, NETLOG_VERBOSE, ("cudp verbose %d\n", ++iCount));
+    assert((iCount == 1) && !strcmp(g_strPrintf, "cudp warning\nhttp error\nvoip verbose 1\n"));
+
+    NetLogSetLevel(NETLOG_INFO);
+    NetPrintfHook(NULL, NULL);
+}
+static uint8_t g_aBinLog[16*1024];
+static int32_t g_iBinLogLen;
+
+static int32_t _NetPrintfBinTestHook(void *pParm, const void *pData, int32_t iLength) {
+    assert(g_iBinLogLen + iLength <= (int32_t)sizeof(g_aBinLog));
+    memcpy(g_aBinLog + g_iBinLogLen, pData, iLength);
+    g_iBinLogLen += iLength;
+    return(0);
+}
+
+//! second sink; only counts what it receives
+static int32_t g_iBinLog2Len;
+
+static int32_t _NetPrintfBinTestHook2(void *pParm, const void *pData, int32_t iLength) {
+    g_iBinLog2Len += iLength;
+    return(0);
+}
+
+/* render the captured records into g_strPrintf, reading all definitions first like
+   logdecode does (formats from earlier calls are kept, as one hook's stream spans
+   several calls); returns the number of definition records */
+static int32_t _NetPrintfBinTestDecode(int32_t *pEarly) {
+    static char strFormats[64][256];
+    char strLine[NETPRINTF_MAXTEXT];
+    int32_t iOffset, iDefs = 0, iEarly = 0, iPass;
+    uint16_t uFmtId, uLength, uNewId;
+
+    _NetPrintfTestReset();
+    for (iPass = 0; iPass < 2; iPass++) {
+        for (iOffset = 0; iOffset < g_iBinLogLen; iOffset += NETPRINTF_BINHEADER + uLength) {
+            memcpy(&uFmtId, g_aBinLog + iOffset, 2);
+            memcpy(&uLength, g_aBinLog + iOffset + 2, 2);
+            if ((iPass == 0) && (uFmtId == 0)) {
+                memcpy(&uNewId, g_aBinLog + iOffset + NETPRINTF_BINHEADER, 2);
+                assert((uNewId < 64) && (uLength - 2 < 256));
+                memcpy(strFormats[uNewId], g_aBinLog + iOffset + NETPRINTF_BINHEADER + 2, uLength - 2);
+                strFormats[uNewId][uLength - 2] = '\0';
+                iDefs += 1;
+            } else if ((iPass == 0) && (strFormats[uFmtId][0] == '\0')) {
+                iEarly += 1;
+            } else if ((iPass == 1) && (uFmtId != 0)) {
+                assert((uFmtId < 64) && (strFormats[uFmtId][0] != '\0'));
+                assert(NetPrintfBinRender(strFormats[uFmtId], g_aBinLog + iOffset + NETPRINTF_BINHEADER, uLength, strLine, sizeof(strLine)) >= 0);
+                _NetPrintfTestHook(NULL, strLine);
+            }
+        }
+        assert(iOffset == g_iBinLogLen);
+    }
+    g_iBinLogLen = 0;
+    if (pEarly != NULL) {
+        *pEarly = iEarly;
+    }
+    return(iDefs);
+}
+
+static int32_t g_iBinSiteD, g_bBinTestGo;
+
+static void *_NetPrintfBinTestThread(void *pArg) {
+    if (pArg != NULL) {
+        // claim a ring, then log the site once the other thread has defined it
+        NetPrintf(("d ready\n"));
+        __atomic_store_n((int32_t *)pArg, 1, __ATOMIC_RELEASE);
+        while (!__atomic_load_n(&g_bBinTestGo, __ATOMIC_ACQUIRE))
+            ;
+    }
+    NetPrintfBinCode(&g_iBinSiteD, "d %d\n", (pArg != NULL) ? 2 : 1);
+    return(NULL);
+}
+
+void test_NetPrintfBin(void) {
+    static int32_t iSiteA = 0, iSiteB = 0, iSiteC = 0, iSiteE = 0;
+    char strExpect[1024], strLong[2048];
+    void *pPtr = &iSiteA;
+    pthread_t aThreads[2];
+    int32_t i, iReady, iEarly;
+
+    NetPrintfHook(_NetPrintfTestHook, NULL);
+
+    // no binary sink: text
+    _NetPrintfTestReset();
+    NetPrintfBinCode(&iSiteA, "a %d %s\n", 1, "x");
+    assert(!strcmp(g_strPrintf, "a 1 x\n") && (iSiteA == 0));
+
+    // each conversion type round trips through a record
+    NetPrintfBinHook(_NetPrintfBinTestHook, NULL);
+    _NetPrintfTestReset();
+    g_iBinLogLen = 0;
+    for (i = 0; i < 2; i++) {
+        NetPrintfBinCode(&iSiteA, "a %d %s\n", i, "x");
+    }
+    NetPrintfBinCode(&iSiteB, "b %05u %lx %lld %zu %.2f %p %-4s| 100%% %c %s\n", 42u, 0xdeadbeefUL, -5LL, (size_t)7, 3.14159, pPtr, "ab", 'z', (const char *)NULL);
+    assert((iSiteA > 0) && (iSiteB > 0) && (iSiteA != iSiteB));
+    assert(g_iPrintfLines == 0);
+    assert(_NetPrintfBinTestDecode(NULL) == 2);
+    snprintf(strExpect, sizeof(strExpect), "a 0 x\na 1 x\nb %05u %lx %lld %zu %.2f %p %-4s| 100%% %c %s\n", 42u, 0xdeadbeefUL, -5LL, (size_t)7, 3.14159, pPtr, "ab", 'z', "(null)");
+    assert(!strcmp(g_strPrintf, strExpect));
+
+    // unsupported conversions stay text
+    _NetPrintfTestReset();
+    NetPrintfBinCode(&iSiteC, "c %*d\n", 3, 4);
+    assert((iSiteC < 0) && !strcmp(g_strPrintf, "c   4\n") && (g_iBinLogLen == 0));
+    _NetPrintfTestReset();
+    NetPrintfBinCode(&iSiteE, "e %lc\n", (wint_t)'w');
+    assert((iSiteE < 0) && !strcmp(g_strPrintf, "e w\n") && (g_iBinLogLen == 0));
+
+    // long strings are truncated to fit the record
+    memset(strLong, 'y', sizeof(strLong) - 1);
+    strLong[sizeof(strLong) - 1] = '\0';
+    NetPrintfBinCode(&iSiteA, "a %d %s\n", 2, strLong);
+    assert((g_iBinLogLen <= NETPRINTF_MAXTEXT) && (_NetPrintfBinTestDecode(NULL) == 0));
+    assert(!strncmp(g_strPrintf, "a 2 yyyy", 8) && (g_strPrintf[g_iPrintfLen - 1] == '\n'));
+
+    // a new sink gets the definitions again, and async output carries records
+    NetPrintfBinHook(_NetPrintfBinTestHook, NULL);
+    assert(NetPrintfAsyncStart() == 0);
+    NetPrintfBinCode(&iSiteB, "b %05u %lx %lld %zu %.2f %p %-4s| 100%% %c %s\n", 42u, 0xdeadbeefUL, -5LL, (size_t)7, 3.14159, pPtr, "ab", 'z', (const char *)NULL);
+    NetPrintfBinCode(&iSiteA, "a %d %s\n", 3, "x");
+    NetPrintfAsyncStop();
+    assert(_NetPrintfBinTestDecode(NULL) == 2);
+    snprintf(strExpect, sizeof(strExpect), "b %05u %lx %lld %zu %.2f %p %-4s| 100%% %c %s\na 3 x\n", 42u, 0xdeadbeefUL, -5LL, (size_t)7, 3.14159, pPtr, "ab", 'z', "(null)");
+    assert(!strcmp(g_strPrintf, strExpect));
+
+    /* with async output, a record in a lower ring can drain before its definition from
+       a higher one: stall the drain on a text line while one thread defines the site and
+       an older thread with a lower ring logs it */
+    NetPrintfBinHook(_NetPrintfBinTestHook, NULL);
+    _NetPrintfTestReset();
+    assert(NetPrintfAsyncStart() == 0);
+    __atomic_store_n(&g_bPrintfBlock, 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&g_bPrintfBlocked, 0, __ATOMIC_RELEASE);
+    NetPrintf(("first\n"));
+    while (!__atomic_load_n(&g_bPrintfBlocked, __ATOMIC_ACQUIRE))
+        ;
+    iReady = 0;
+    pthread_create(&aThreads[0], NULL, _NetPrintfBinTestThread, &iReady);
+    while (!__atomic_load_n(&iReady, __ATOMIC_ACQUIRE))
+        ;
+    pthread_create(&aThreads[1], NULL, _NetPrintfBinTestThread, NULL);
+    pthread_join(aThreads[1], NULL);
+    __atomic_store_n(&g_bBinTestGo, 1, __ATOMIC_RELEASE);
+    pthread_join(aThreads[0], NULL);
+    __atomic_store_n(&g_bPrintfBlock, 0, __ATOMIC_RELEASE);
+    NetPrintfAsyncStop();
+    assert(!strcmp(g_strPrintf, "first\nd ready\n"));
+    assert((_NetPrintfBinTestDecode(&iEarly) == 1) && (iEarly == 1));
+    assert(!strcmp(g_strPrintf, "d 2\nd 1\n") || !strcmp(g_strPrintf, "d 1\nd 2\n"));
+
+    // records queued when the sink changes go to the old sink, with their definition
+    NetPrintfBinHook(_NetPrintfBinTestHook, NULL);
+    assert(NetPrintfAsyncStart() == 0);
+    NetPrintfBinCode(&iSiteA, "a %d %s\n", 4, "x");
+    g_iBinLog2Len = 0;
+    NetPrintfBinHook(_NetPrintfBinTestHook2, NULL);
+    assert(g_iBinLog2Len == 0);
+    assert((_NetPrintfBinTestDecode(NULL) == 1) && !strcmp(g_strPrintf, "a 4 x\n"));
+    NetPrintfBinCode(&iSiteA, "a %d %s\n", 5, "x");
+    NetPrintfAsyncStop();
+    assert((g_iBinLog2Len > 0) && (g_iBinLogLen == 0));
+
+    // a payload that does not match its format is rejected
+    assert(NetPrintfBinRender("%d %d", g_aBinLog, 4, strExpect, sizeof(strExpect)) < 0);
+
+    NetPrintfBinHook(NULL, NULL);
+    NetPrintfHook(NULL, NULL);
+}
+
+void test_NetIdle(void) {
+    NetIdleStatT stat;
+    int32_t i, iSelf = 0;
+
+    NetCritInit(_NetLib_pIdleCrit, "idle");
+    assert(DirtyMemArenaCreate(0) == 0);
+    NetIdleReset();
+    NetTickStubSet(1000);
+
+    // more every-call tasks than the static storage holds
+    for (i = 0; i < 63; i++) {
+        NetIdleAdd(_IdleCount, &g_aIdleCount[i]);
+    }
+    NetIdleAdd(_IdleSelfDel, &iSelf);
+    NetIdleCall();
+    for (i = 0; i < 63; i++) {
+        assert(g_aIdleCount[i] == 1);
+    }
+    assert((iSelf == 1) && (g_aIdleCount[99] <= 1));
+    for (i = 0; i < 63; i += 2) {
+        NetIdleDel(_IdleCount, &g_aIdleCount[i]);
+    }
+    NetIdleCall();
+    NetIdleCall();
+    for (i = 0; i < 63; i++) {
+        assert(g_aIdleCount[i] == ((i & 1) ? 3 : 1));
+    }
+    assert(iSelf == 1);
+    assert(NetIdleStat(_IdleSelfDel, &iSelf, &stat) < 0);
+    assert(NetIdleStat(_IdleCount, &g_aIdleCount[1], &stat) == 0);
+    assert((stat.uCalls == 3) && (stat.aRunHist[0] == 3));
+    NetIdleReset();
+
+    // interval tasks run earliest deadline first, once per call, skipping missed intervals
+    NetIdleAddInterval(_IdleLog, (void *)1, 10);
+    NetIdleAddInterval(_IdleLog, (void *)2, 25);
+    NetIdleAddInterval(_IdleLog, (void *)3, 20);
+    g_iIdleLog = 0;
+    NetTickStubSet(1009);
+    NetIdleCall();
+    assert(g_iIdleLog == 0);
+    NetTickStubSet(1020);
+    NetIdleCall();
+    assert((g_iIdleLog == 2) && (g_aIdleLog[0] == 1) && (g_aIdleLog[1] == 3));
+    NetTickStubSet(1100);
+    NetIdleCall();
+    assert((g_iIdleLog == 5) && (g_aIdleLog[2] == 2) && (g_aIdleLog[3] == 1) && (g_aIdleLog[4] == 3));
+    assert(NetIdleStat(_IdleLog, (void *)1, &stat) == 0);
+    assert((stat.uCalls == 2) && (stat.uMissed == 8));
+    assert(NetIdleStat(_IdleLog, (void *)2, &stat) == 0);
+    assert((stat.uCalls == 1) && (stat.uMissed == 3));
+    NetTickStubSet(1109);
+    NetIdleCall();
+    assert(g_iIdleLog == 5);
+    NetIdleDel(_IdleLog, (void *)3);
+    NetTickStubSet(1130);
+    NetIdleCall();
+    assert((g_iIdleLog == 7) && (g_aIdleLog[5] == 1) && (g_aIdleLog[6] == 2));
+    NetIdleReset();
+
+    // deadlines compare correctly across tick wrap
+    NetTickStubSet(0xfffffff0);
+    NetIdleAddInterval(_IdleLog, (void *)4, 0x20);
+    g_iIdleLog = 0;
+    NetTickStubSet(0xfffffffa);
+    NetIdleCall();
+    assert(g_iIdleLog == 0);
+    NetTickStubSet(0x100000010ull);
+    NetIdleCall();
+    assert((g_iIdleLog == 1) && (g_aIdleLog[0] == 4));
+    NetIdleReset();
+
+    DirtyMemArenaDestroy();
+    NetCritKill(_NetLib_pIdleCrit);
+}
+
+void test_DirtyMemArena(void) {
+    DirtyMemArenaStatT stat;
+    void *pMem[64], *pLarge, *pReuse;
+    uint32_t uBytes = 0;
+    int32_t i;
+
+    assert(DirtyMemArenaCreate(0) == 0);
+
+    for (i = 0; i < 64; i++) {
+        pMem[i] = DirtyMemAlloc(1 + i*500, COMMUDP_MEMID, 1, NULL);
+        assert(pMem[i] != NULL);
+        assert(((uintptr_t)pMem[i] & 15) == 0);
+        memset(pMem[i], i, 1 + i*500);
+        uBytes += 1 + i*500;
+    }
+    pLarge = DirtyMemAlloc(100000, VOIP_MEMID, 2, NULL);
+    assert(pLarge != NULL);
+    memset(pLarge, 0xff, 100000);
+
+    assert(DirtyMemArenaGroupStat(1, &stat) == 0);
+    assert(stat.iLiveCount == 64);
+    assert(stat.iLiveBytes == uBytes);
+    assert(DirtyMemArenaModuleStat(COMMUDP_MEMID, &stat) == 0);
+    assert(stat.iLiveBytes == uBytes);
+
+    // a freed block is handed out again for the same size class
+    DirtyMemFree(pMem[10], COMMUDP_MEMID, 1, NULL);
+    pReuse = DirtyMemAlloc(1 + 10*500, COMMUDP_MEMID, 1, NULL);
+    assert(pReuse == pMem[10]);
+    assert(((uint8_t *)pMem[11])[0] == 11);
+
+    // releasing group 1 leaves group 2 intact
+    DirtyMemArenaRelease(1);
+    assert(DirtyMemArenaGroupStat(1, &stat) < 0);
+    assert(DirtyMemArenaModuleStat(COMMUDP_MEMID, &stat) < 0);
+    assert(DirtyMemArenaGroupStat(2, &stat) == 0);
+    assert(stat.iLiveBytes == 100000);
+
+    DirtyMemFree(pLarge, VOIP_MEMID, 2, NULL);
+    assert(DirtyMemArenaModuleStat(VOIP_MEMID, &stat) == 0);
+    assert((stat.iLiveCount == 0) && (stat.iPeakBytes == 100000));
+
+    DirtyMemArenaDestroy();
+}
+
+static void *_DirtyMemGroupThread(void *pArg) {
+    int32_t iGroup = -1;
+    void *pUserData = &iGroup;
+    DirtyMemGroupQuery(&iGroup, &pUserData);
+    *(int32_t *)pArg = ((iGroup == 0) && (pUserData == NULL));
+    return NULL;
+}
+
+void test_DirtyMemGroup(void) {
+    pthread_t thread;
+    int32_t i, iGroup, bDefault = 0;
+    void *pUserData;
+
+    DirtyMemGroupEnter('grp1', &iGroup);
+    DirtyMemGroupEnter('grp2', NULL);
+    DirtyMemGroupQuery(&iGroup, &pUserData);
+    assert((iGroup == 'grp2') && (pUserData == NULL));
+
+    // other threads have their own stack
+    pthread_create(&thread, NULL, _DirtyMemGroupThread, &bDefault);
+    pthread_join(thread, NULL);
+    assert(bDefault);
+
+    DirtyMemGroupLeave();
+    DirtyMemGroupQuery(&iGroup, &pUserData);
+    assert((iGroup == 'grp1') && (pUserData == &iGroup));
+    DirtyMemGroupLeave();
+    DirtyMemGroupLeave();
+    DirtyMemGroupQuery(&iGroup, NULL);
+    assert(iGroup == 0);
+
+    // leaves matching dropped enters do not pop the enclosing groups
+    for (i = 0; i < DIRTYMEM_MAXGROUPS + 3; i++) {
+        DirtyMemGroupEnter(i + 1, NULL);
+    }
+    for (i = 0; i < 3; i++) {
+        DirtyMemGroupLeave();
+    }
+    DirtyMemGroupQuery(&iGroup, NULL);
+    assert(iGroup == DIRTYMEM_MAXGROUPS);
+    DirtyMemGroupLeave();
+    DirtyMemGroupQuery(&iGroup, NULL);
+    assert(iGroup == DIRTYMEM_MAXGROUPS - 1);
+    for (i = 1; i < DIRTYMEM_MAXGROUPS; i++) {
+        DirtyMemGroupLeave();
+    }
+    DirtyMemGroupQuery(&iGroup, NULL);
+    assert(iGroup == 0);
+}
+
+static void *_DirtyMemArenaThread(void *pArg) {
+    void **pMem = (void **)pArg;
+    void *aOwn[100];
+    int32_t i;
+    // free the main thread's blocks, then churn our own
+    for (i = 0; i < 100; i++) {
+        DirtyMemFree(pMem[i], COMMUDP_MEMID, 1, NULL);
+        aOwn[i] = DirtyMemAlloc(24 + i, VOIP_MEMID, 1, NULL);
+    }
+    for (i = 0; i < 100; i++) {
+        DirtyMemFree(aOwn[i], VOIP_MEMID, 1, NULL);
+    }
+    return NULL;
+}
+
+void test_DirtyMemArenaThreadCache(void) {
+    DirtyMemArenaStatT stat;
+    pthread_t thread;
+    void *pMem[100];
+    int32_t i;
+
+    assert(DirtyMemArenaCreate(DIRTYMEM_ARENA_FLAG_THREADCACHE) == 0);
+    for (i = 0; i < 100; i++) {
+        pMem[i] = DirtyMemAlloc(8 + i*20, COMMUDP_MEMID, 1, NULL);
+        assert(pMem[i] != NULL);
+    }
+    DirtyMemArenaThreadFlush();
+    assert(DirtyMemArenaGroupStat(1, &stat) == 0);
+    assert(stat.iLiveCount == 100);
+
+    pthread_create(&thread, NULL, _DirtyMemArenaThread, pMem);
+    pthread_join(thread, NULL);
+
+    // the worker flushed its cache on exit
+    assert(DirtyMemArenaGroupStat(1, &stat) == 0);
+    assert((stat.iLiveCount == 0) && (stat.iLiveBytes == 0) && (stat.uTotalAllocs == 200));
+    assert(DirtyMemArenaModuleStat(VOIP_MEMID, &stat) == 0);
+    assert((stat.iLiveCount == 0) && (stat.uTotalAllocs == 100));
+
+    DirtyMemArenaDestroy();
+}
+
+#define DIRTYMEM_TRACKTHREADS   (4)
+#define DIRTYMEM_TRACKITERS     (5000)
+
+static pthread_barrier_t g_DirtyMemTrackBarrier;
+
+static void *_DirtyMemTrackThread(void *pArg) {
+    void *aMem[8];
+    int32_t i, j;
+    for (i = 0; i < DIRTYMEM_TRACKITERS; i++) {
+        for (j = 0; j < 8; j++) {
+            aMem[j] = DirtyMemAlloc(16 + j, PROTOHTTP_MEMID, 3, NULL);
+        }
+        // once, hold every thread's 8 allocations live together: the exact peak
+        if (i == DIRTYMEM_TRACKITERS/2) {
+            pthread_barrier_wait(&g_DirtyMemTrackBarrier);
+        }
+        for (j = 0; j < 8; j++) {
+            DirtyMemFree(aMem[j], PROTOHTTP_MEMID, 3, NULL);
+        }
+    }
+    return(NULL);
+}
+
+void test_DirtyMemDebug(void) {
+    DirtyMemDebugStatT stat;
+    char strReport[4096];
+    void *pMem[16], *pLarge;
+    pthread_t aThreads[DIRTYMEM_TRACKTHREADS];
+    int32_t i;
+
+    assert(DirtyMemArenaCreate(0) == 0);
+    DirtyMemDebugCreate(1);
+    for (i = 0; i < 16; i++) {
+        pMem[i] = DirtyMemAlloc(100, COMMUDP_MEMID, 1, NULL);
+    }
+    pLarge = DirtyMemAlloc(50000, VOIP_MEMID, 2, NULL);
+    assert(DirtyMemDebugModuleStat(COMMUDP_MEMID, &stat) == 0);
+    assert((stat.iLiveBytes == 1600) && (stat.iLiveCount == 16));
+    assert(DirtyMemDebugGroupStat(2, &stat) == 0);
+    assert(stat.iLiveBytes == 50000);
+
+    // size, module and group come from the tracked allocation, not the caller
+    for (i = 0; i < 8; i++) {
+        DirtyMemFree(pMem[i], 0, 0, NULL);
+    }
+    assert(DirtyMemDebugModuleStat(COMMUDP_MEMID, &stat) == 0);
+    assert((stat.iLiveBytes == 800) && (stat.iPeakBytes == 1600) && (stat.iPeakCount == 16));
+
+    assert(DirtyMemDebugReport(strReport, sizeof(strReport)) > 0);
+    assert(strstr(strReport, "module 'cudp' live 800 bytes in 8 allocs") != NULL);
+
+    // releasing a group forgets its allocations
+    DirtyMemArenaRelease(1);
+    assert(DirtyMemDebugGroupStat(1, &stat) == 0);
+    assert((stat.iLiveCount == 0) && (stat.iLiveBytes == 0));
+    DirtyMemFree(pLarge, VOIP_MEMID, 2, NULL);
+    assert(DirtyMemDebugModuleStat(VOIP_MEMID, &stat) == 0);
+    assert((stat.iLiveCount == 0) && (stat.iPeakBytes == 50000));
+    assert(DirtyMemDebugModuleStat(PROTOHTTP_MEMID, &stat) < 0);
+
+    // concurrent allocations return to zero, and the peak is what was live at once
+    pthread_barrier_init(&g_DirtyMemTrackBarrier, NULL, DIRTYMEM_TRACKTHREADS);
+    for (i = 0; i < DIRTYMEM_TRACKTHREADS; i++) {
+        pthread_create(&aThreads[i], NULL, _DirtyMemTrackThread, NULL);
+    }
+    for (i = 0; i < DIRTYMEM_TRACKTHREADS; i++) {
+        pthread_join(aThreads[i], NULL);
+    }
+    pthread_barrier_destroy(&g_DirtyMemTrackBarrier);
+    assert(DirtyMemDebugModuleStat(PROTOHTTP_MEMID, &stat) == 0);
+    assert((stat.iLiveBytes == 0) && (stat.iLiveCount == 0));
+    assert((stat.iPeakCount == 8*DIRTYMEM_TRACKTHREADS) && (stat.iPeakBytes == 156*DIRTYMEM_TRACKTHREADS));
+    assert(DirtyMemDebugGroupStat(3, &stat) == 0);
+    assert((stat.iLiveBytes == 0) && (stat.iLiveCount == 0));
+    assert((stat.iPeakCount == 8*DIRTYMEM_TRACKTHREADS) && (stat.iPeakBytes == 156*DIRTYMEM_TRACKTHREADS));
+
+    DirtyMemDebugDestroy();
+    DirtyMemArenaDestroy();
+}
+
 int main(void) {
     printf("Running tests...\n");
     
     test_CommUDPSetConnID();
+    test_CommUDPParseConnStr();
     test_NetHash();
+    test_NetHashBatch();
+    test_NetHash64();
+    test_SocketInAddrText();
+    test_NetTick();
+    test_NetCrit();
+    test_NetCritStat();
+    test_NetPrintf();
+    test_NetPrintfLevel();
+    test_NetPrintfBin();
+    test_NetIdle();
+    test_DirtyMemGroup();
+    test_DirtyMemArena();
+    test_DirtyMemArenaThreadCache();
+    test_DirtyMemDebug();
     
     printf("All tests passed!\n");
     return 0;
@@ -0,0 +1,17 @@
+// compile-time NetHash checks; build with: g++ -std=c++11 v5.6.2_const.cpp
+#include <stdio.h>
+#include "../5.6.2/dirtysock.h"
+
+// 5.6.2 connident hashes the text after '#'
+static_assert(NetHashConst("$c0a8015a$c0a8015a-$c0a8015a$c0a8015a") == (int32_t)0xC6627546, "NetHashConst differs from 5.6.2 connident");
+// 4.7.0 connident hashes from the '#' itself
+static_assert(NetHashConst("#$c0a8015a$c0a8015a-$c0a8015a$c0a8015a") == (int32_t)0x08F43358, "NetHashConst differs from 4.7.0 connident");
+// bytes >= 0x80 are sign-extended like in NetHash()
+static_assert(NetHashConst("\xff\x80") == (int32_t)0xffffff9f, "NetHashConst char sign extension");
+static_assert(NetHashConst("") == 0, "NetHashConst empty string");
+
+int main(void) {
+    printf("Running tests...\n");
+    printf("All tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,14 @@
+// NetCrit tests without DIRTYCODE_CRITSTATS, the production configuration; build with: gcc -Wno-multichar v5.6.2_netcrit.c -lpthread
+#include <stdio.h>
+#include "../5.6.2/dirtylib.c"
+#include "../5.6.2/dirtymem.c"
+#include "../5.6.2/dirtymemarena.c"
+#include "dirtylibstub.h"
+#include "netcrittest.h"
+
+int main(void) {
+    printf("Running tests...\n");
+    test_NetCrit();
+    printf("All tests passed!\n");
+    return 0;
+}